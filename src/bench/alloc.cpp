@@ -0,0 +1,81 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "bench/bench.h"
+
+// Replacements for the global allocation functions which count every
+// allocation made by the benchmark binary. The aligned variants are left to
+// the standard library; nothing in ProjectorRays uses over-aligned types.
+
+static std::atomic<uint64_t> g_allocationCount(0);
+static std::atomic<uint64_t> g_allocatedBytes(0);
+
+static void *countedAlloc(std::size_t size) {
+	g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+	g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	return std::malloc(size ? size : 1);
+}
+
+void *operator new(std::size_t size) {
+	void *ptr = countedAlloc(size);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void *operator new[](std::size_t size) {
+	void *ptr = countedAlloc(size);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+	return countedAlloc(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+	return countedAlloc(size);
+}
+
+void operator delete(void *ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+	std::free(ptr);
+}
+
+namespace Bench {
+
+AllocationCounts allocationCounts() {
+	AllocationCounts counts;
+	counts.count = g_allocationCount.load(std::memory_order_relaxed);
+	counts.bytes = g_allocatedBytes.load(std::memory_order_relaxed);
+	return counts;
+}
+
+} // namespace Bench
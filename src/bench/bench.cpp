@@ -0,0 +1,210 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <boost/format.hpp>
+
+#include "bench/bench.h"
+#include "common/json.h"
+#include "common/log.h"
+#include "common/util.h"
+
+namespace Bench {
+
+static double perSecond(uint64_t count, double seconds) {
+	if (count == 0 || seconds <= 0.0)
+		return 0.0;
+	return count / seconds;
+}
+
+/* Result */
+
+double Result::mean() const {
+	if (samples.empty())
+		return 0.0;
+
+	double total = 0.0;
+	for (double sample : samples) {
+		total += sample;
+	}
+	return total / samples.size();
+}
+
+double Result::median() const {
+	if (samples.empty())
+		return 0.0;
+
+	std::vector<double> sorted = samples;
+	std::sort(sorted.begin(), sorted.end());
+	size_t mid = sorted.size() / 2;
+	if (sorted.size() % 2 == 0)
+		return (sorted[mid - 1] + sorted[mid]) / 2.0;
+	return sorted[mid];
+}
+
+double Result::stddev() const {
+	if (samples.size() < 2)
+		return 0.0;
+
+	// Sample standard deviation
+	double m = mean();
+	double sum = 0.0;
+	for (double sample : samples) {
+		sum += (sample - m) * (sample - m);
+	}
+	return std::sqrt(sum / (samples.size() - 1));
+}
+
+double Result::min() const {
+	if (samples.empty())
+		return 0.0;
+	return *std::min_element(samples.begin(), samples.end());
+}
+
+double Result::max() const {
+	if (samples.empty())
+		return 0.0;
+	return *std::max_element(samples.begin(), samples.end());
+}
+
+void Result::writeJSON(Common::JSONWriter &json) const {
+	double med = median();
+	double m = mean();
+	double sd = stddev();
+
+	json.startObject();
+		json.writeField("name", name);
+		json.writeField("fixture", fixture);
+		json.writeField("stage", IO::stageName(stage));
+		json.writeField("iterations", (uint64_t)iterations);
+		json.writeKey("samples");
+		json.startArray();
+			for (double sample : samples) {
+				json.writeVal(sample);
+			}
+		json.endArray();
+		json.writeField("mean", m);
+		json.writeField("median", med);
+		json.writeField("stddev", sd);
+		json.writeField("cv", (m > 0.0) ? sd / m : 0.0);
+		json.writeField("min", min());
+		json.writeField("max", max());
+		json.writeField("bytes", counters.bytes);
+		json.writeField("bytecodes", counters.bytecodes);
+		json.writeField("handlers", counters.handlers);
+		json.writeField("chunks", counters.chunks);
+		json.writeField("mbPerSec", perSecond(counters.bytes, med) / 1e6);
+		json.writeField("bytecodesPerSec", perSecond(counters.bytecodes, med));
+		json.writeField("handlersPerSec", perSecond(counters.handlers, med));
+		json.writeField("usPerChunk", (counters.chunks > 0) ? med / counters.chunks * 1e6 : 0.0);
+		json.writeField("allocations", allocations);
+		json.writeField("allocatedBytes", allocatedBytes);
+	json.endObject();
+}
+
+/* Runner */
+
+void Runner::add(Benchmark benchmark) {
+	_benchmarks.push_back(std::move(benchmark));
+}
+
+bool Runner::matches(const Benchmark &benchmark) const {
+	if (_options.filter.empty())
+		return true;
+
+	std::string fullName = benchmark.name + "/" + benchmark.fixture;
+	return fullName.find(_options.filter) != std::string::npos;
+}
+
+double Runner::runIteration(const Benchmark &benchmark, Counters &counters, AllocationCounts &allocations) {
+	if (benchmark.setup)
+		benchmark.setup();
+
+	AllocationCounts before = allocationCounts();
+	auto start = std::chrono::steady_clock::now();
+	benchmark.run(counters);
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	AllocationCounts after = allocationCounts();
+
+	allocations.count += after.count - before.count;
+	allocations.bytes += after.bytes - before.bytes;
+	return elapsed.count();
+}
+
+Result Runner::run(const Benchmark &benchmark) {
+	Result result;
+	result.name = benchmark.name;
+	result.fixture = benchmark.fixture;
+	result.stage = benchmark.stage;
+
+	// Warm up and calibrate: repeat iterations until one sample's worth of
+	// time has passed, so short benchmarks aren't dominated by clock noise.
+	AllocationCounts allocations;
+	double elapsed = runIteration(benchmark, result.counters, allocations);
+	size_t iterations = 1;
+	while (elapsed < _options.minSampleTime) {
+		Counters discarded;
+		elapsed += runIteration(benchmark, discarded, allocations);
+		iterations++;
+	}
+	result.iterations = iterations;
+
+	allocations = AllocationCounts();
+	for (size_t i = 0; i < _options.samples; i++) {
+		double sampleTime = 0.0;
+		for (size_t j = 0; j < iterations; j++) {
+			Counters discarded;
+			sampleTime += runIteration(benchmark, discarded, allocations);
+		}
+		result.samples.push_back(sampleTime / iterations);
+	}
+
+	size_t totalIterations = _options.samples * iterations;
+	if (totalIterations > 0) {
+		result.allocations = (double)allocations.count / totalIterations;
+		result.allocatedBytes = (double)allocations.bytes / totalIterations;
+	}
+	return result;
+}
+
+std::vector<Result> Runner::runAll() {
+	std::vector<Result> results;
+	for (const auto &benchmark : _benchmarks) {
+		if (!matches(benchmark))
+			continue;
+
+		Result result = run(benchmark);
+		double med = result.median();
+		double m = result.mean();
+		Common::log(boost::format("%-24s %-16s %12.3f us  +/- %5.1f%%  %10.2f MB/s  %12.1f allocs")
+			% result.name % result.fixture % (med * 1e6)
+			% ((m > 0.0) ? result.stddev() / m * 100.0 : 0.0)
+			% (perSecond(result.counters.bytes, med) / 1e6)
+			% result.allocations);
+		results.push_back(std::move(result));
+	}
+	return results;
+}
+
+void writeResultsJSON(Common::JSONWriter &json, const RunnerOptions &options, const std::vector<Result> &results) {
+	json.startObject();
+		json.writeField("version", STR(VERSION_NUMBER));
+		json.writeField("gitSha", STR(GIT_SHA));
+		json.writeField("samples", (uint64_t)options.samples);
+		json.writeField("minSampleTime", options.minSampleTime);
+		json.writeKey("benchmarks");
+		json.startArray();
+			for (const auto &result : results) {
+				result.writeJSON(json);
+			}
+		json.endArray();
+	json.endObject();
+}
+
+} // namespace Bench
@@ -0,0 +1,104 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BENCH_BENCH_H
+#define BENCH_BENCH_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "io/stats.h"
+
+namespace Common {
+class JSONWriter;
+}
+
+namespace Bench {
+
+/* Allocation counting, implemented by the global operator new in alloc.cpp */
+
+struct AllocationCounts {
+	uint64_t count = 0;
+	uint64_t bytes = 0;
+};
+
+AllocationCounts allocationCounts();
+
+/* Counters */
+
+// Work done by one iteration of a benchmark, used to derive throughput
+struct Counters {
+	uint64_t bytes = 0;
+	uint64_t bytecodes = 0;
+	uint64_t handlers = 0;
+	uint64_t chunks = 0;
+};
+
+/* Benchmark */
+
+struct Benchmark {
+	std::string name;
+	std::string fixture;
+	IO::Stage stage;
+
+	// Runs before every iteration and is not timed
+	std::function<void()> setup;
+	// The timed part of an iteration
+	std::function<void(Counters &)> run;
+};
+
+/* Result */
+
+struct Result {
+	std::string name;
+	std::string fixture;
+	IO::Stage stage;
+	size_t iterations = 0; // per sample
+	std::vector<double> samples; // seconds per iteration
+	Counters counters;
+	double allocations = 0.0; // per iteration
+	double allocatedBytes = 0.0; // per iteration
+
+	double mean() const;
+	double median() const;
+	double stddev() const;
+	double min() const;
+	double max() const;
+
+	void writeJSON(Common::JSONWriter &json) const;
+};
+
+/* Runner */
+
+struct RunnerOptions {
+	size_t samples = 10;
+	double minSampleTime = 0.05; // seconds
+	std::string filter;
+};
+
+class Runner {
+private:
+	RunnerOptions _options;
+	std::vector<Benchmark> _benchmarks;
+
+	double runIteration(const Benchmark &benchmark, Counters &counters, AllocationCounts &allocations);
+
+public:
+	Runner(const RunnerOptions &options) : _options(options) {}
+
+	void add(Benchmark benchmark);
+	bool matches(const Benchmark &benchmark) const;
+	Result run(const Benchmark &benchmark);
+	std::vector<Result> runAll();
+};
+
+void writeResultsJSON(Common::JSONWriter &json, const RunnerOptions &options, const std::vector<Result> &results);
+
+} // namespace Bench
+
+#endif // BENCH_BENCH_H
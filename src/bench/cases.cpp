@@ -0,0 +1,493 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "bench/bench.h"
+#include "bench/cases.h"
+#include "common/json.h"
+#include "common/stream.h"
+#include "common/util.h"
+#include "director/chunk.h"
+#include "director/dirfile.h"
+#include "lingodec/ast.h"
+#include "lingodec/context.h"
+#include "lingodec/handler.h"
+#include "lingodec/names.h"
+#include "lingodec/script.h"
+
+namespace fs = std::filesystem;
+
+using Director::DirectorFile;
+using Director::ScriptChunk;
+
+namespace Bench {
+
+// Keeps the results of read-only benchmarks alive so they can't be optimized away
+static volatile uint32_t g_sink;
+
+/* Fixture */
+
+Fixture::Fixture(const std::string &n, const Gen::GeneratorOptions &o) : name(n), options(o) {
+	Gen::GeneratorOptions rifxOptions = options;
+	rifxOptions.container = Gen::kContainerRIFX;
+	rifx = Gen::Generator(rifxOptions).build();
+
+	Gen::GeneratorOptions abOptions = options;
+	abOptions.container = Gen::kContainerAfterburner;
+	afterburner = Gen::Generator(abOptions).build();
+
+	std::vector<uint32_t> words(afterburner.size() / 4);
+	Common::ReadStream wordStream(afterburner.data(), words.size() * 4);
+	size_t varIntsSize = 0;
+	for (auto &word : words) {
+		word = wordStream.readUint32();
+		varIntsSize += Common::WriteStream::varIntSize(word);
+	}
+	varInts.resize(varIntsSize);
+	varIntCount = words.size();
+	Common::WriteStream varIntStream(varInts.data(), varInts.size());
+	for (uint32_t word : words) {
+		varIntStream.writeVarInt(word);
+	}
+}
+
+std::vector<std::string> fixtureNames() {
+	return { "small", "medium", "large" };
+}
+
+std::shared_ptr<Fixture> makeFixture(const std::string &name) {
+	Gen::GeneratorOptions options;
+	options.soundFrames = 38;
+	if (name == "small") {
+		options.castCount = 1;
+		options.scriptsPerCast = 8;
+		options.handlersPerScript = 4;
+		options.statementsPerHandler = 16;
+		options.bitmapsPerCast = 4;
+		options.bitmapSize = 4096;
+		options.soundsPerCast = 1;
+	} else if (name == "medium") {
+		options.castCount = 1;
+		options.scriptsPerCast = 64;
+		options.handlersPerScript = 8;
+		options.statementsPerHandler = 32;
+		options.bitmapsPerCast = 32;
+		options.bitmapSize = 16384;
+		options.soundsPerCast = 4;
+	} else if (name == "large") {
+		options.castCount = 2;
+		options.scriptsPerCast = 256;
+		options.handlersPerScript = 8;
+		options.statementsPerHandler = 64;
+		options.bitmapsPerCast = 64;
+		options.bitmapSize = 65536;
+		options.soundsPerCast = 8;
+	} else {
+		throw std::runtime_error("Unknown fixture '" + name + "'");
+	}
+	return std::make_shared<Fixture>(name, options);
+}
+
+fs::path scratchPath() {
+	return fs::temp_directory_path() / "projectorrays-bench.dir";
+}
+
+/* Movie */
+
+// A fixture loaded into a DirectorFile. The buffer and stream must outlive
+// the DirectorFile, since chunks are read lazily.
+struct Movie {
+	std::vector<uint8_t> buf;
+	Common::ReadStream stream;
+	std::unique_ptr<DirectorFile> dir;
+
+	Movie(const std::vector<uint8_t> &data) : buf(data), stream(buf.data(), buf.size()) {
+		dir = std::make_unique<DirectorFile>();
+	}
+
+	// Positions the stream just past the RIFX header, as read() would
+	void readHeader() {
+		stream.seek(0);
+		stream.endianness = Common::kBigEndian;
+		if (stream.readUint32() == FOURCC('X', 'F', 'I', 'R'))
+			stream.endianness = Common::kLittleEndian;
+		stream.readUint32(); // meta length
+		dir->stream = &stream;
+		dir->endianness = stream.endianness;
+		dir->codec = stream.readUint32();
+		dir->afterburned = (dir->codec == FOURCC('F', 'G', 'D', 'M') || dir->codec == FOURCC('F', 'G', 'D', 'C'));
+	}
+
+	void read() {
+		if (!dir->read(&stream))
+			throw std::runtime_error("Could not read fixture");
+	}
+
+	std::vector<ScriptChunk *> scripts() {
+		std::vector<ScriptChunk *> res;
+		for (const auto *cast : dir->casts) {
+			if (!cast->lctx)
+				continue;
+
+			for (const auto &[scriptId, script] : cast->lctx->scripts) {
+				res.push_back(static_cast<ScriptChunk *>(script));
+			}
+		}
+		return res;
+	}
+};
+
+// Discards each handler's bytecode, freeing its storage, so the next
+// readData() starts from the state a freshly read script would be in.
+static void resetHandlers(Movie &movie) {
+	for (auto *script : movie.scripts()) {
+		for (auto &handler : script->handlers) {
+			handler->bytecodeArray = std::vector<LingoDec::Bytecode>();
+			handler->bytecodePosMap.clear();
+			handler->ast.reset();
+		}
+	}
+}
+
+static void readHandlers(Movie &movie, Counters &counters) {
+	for (const auto &id : movie.dir->chunkIDsByFourCC[FOURCC('L', 's', 'c', 'r')]) {
+		auto *script = static_cast<ScriptChunk *>(movie.dir->getChunk(FOURCC('L', 's', 'c', 'r'), id));
+		Common::BigEndianReadStream stream(movie.dir->getChunkData(FOURCC('L', 's', 'c', 'r'), id));
+		for (auto &handler : script->handlers) {
+			handler->readData(stream);
+			counters.bytes += handler->compiledLen;
+			counters.bytecodes += handler->bytecodeArray.size();
+			counters.handlers++;
+		}
+	}
+}
+
+/* Cases */
+
+static void addStreamCases(Runner &runner, const std::shared_ptr<Fixture> &fixture) {
+	runner.add({ "stream/readUint8", fixture->name, IO::kStageRead, nullptr, [fixture](Counters &counters) {
+		Common::ReadStream stream(fixture->afterburner.data(), fixture->afterburner.size());
+		uint32_t sum = 0;
+		while (!stream.eof()) {
+			sum += stream.readUint8();
+		}
+		g_sink = sum;
+		counters.bytes = stream.pos();
+	} });
+
+	runner.add({ "stream/readUint16BE", fixture->name, IO::kStageRead, nullptr, [fixture](Counters &counters) {
+		Common::ReadStream stream(fixture->afterburner.data(), fixture->afterburner.size() & ~(size_t)1, Common::kBigEndian);
+		uint32_t sum = 0;
+		while (!stream.eof()) {
+			sum += stream.readUint16();
+		}
+		g_sink = sum;
+		counters.bytes = stream.pos();
+	} });
+
+	runner.add({ "stream/readUint32LE", fixture->name, IO::kStageRead, nullptr, [fixture](Counters &counters) {
+		Common::ReadStream stream(fixture->afterburner.data(), fixture->afterburner.size() & ~(size_t)3, Common::kLittleEndian);
+		uint32_t sum = 0;
+		while (!stream.eof()) {
+			sum += stream.readUint32();
+		}
+		g_sink = sum;
+		counters.bytes = stream.pos();
+	} });
+
+	runner.add({ "stream/readVarInt", fixture->name, IO::kStageRead, nullptr, [fixture](Counters &counters) {
+		Common::ReadStream stream(fixture->varInts.data(), fixture->varInts.size());
+		uint32_t sum = 0;
+		while (!stream.eof()) {
+			sum += stream.readVarInt();
+		}
+		g_sink = sum;
+		counters.bytes = stream.pos();
+	} });
+
+	runner.add({ "stream/readVarInts", fixture->name, IO::kStageRead, nullptr, [fixture](Counters &counters) {
+		Common::ReadStream stream(fixture->varInts.data(), fixture->varInts.size());
+		uint32_t sum = 0;
+		uint32_t batch[64];
+		for (size_t left = fixture->varIntCount; left > 0;) {
+			size_t count = std::min(left, sizeof(batch) / sizeof(batch[0]));
+			stream.readVarInts(batch, count);
+			for (size_t i = 0; i < count; i++) {
+				sum += batch[i];
+			}
+			left -= count;
+		}
+		g_sink = sum;
+		counters.bytes = stream.pos();
+	} });
+
+	runner.add({ "stream/readUint16ArrayBE", fixture->name, IO::kStageRead, nullptr, [fixture](Counters &counters) {
+		Common::ReadStream stream(fixture->afterburner.data(), fixture->afterburner.size() & ~(size_t)1, Common::kBigEndian);
+		uint32_t sum = 0;
+		uint16_t batch[256];
+		while (!stream.eof()) {
+			size_t count = std::min((stream.size() - stream.pos()) / 2, sizeof(batch) / sizeof(batch[0]));
+			stream.readUint16Array(batch, count);
+			for (size_t i = 0; i < count; i++) {
+				sum += batch[i];
+			}
+		}
+		g_sink = sum;
+		counters.bytes = stream.pos();
+	} });
+
+	runner.add({ "stream/readUint32ArrayBE", fixture->name, IO::kStageRead, nullptr, [fixture](Counters &counters) {
+		Common::ReadStream stream(fixture->afterburner.data(), fixture->afterburner.size() & ~(size_t)3, Common::kBigEndian);
+		uint32_t sum = 0;
+		uint32_t batch[256];
+		while (!stream.eof()) {
+			size_t count = std::min((stream.size() - stream.pos()) / 4, sizeof(batch) / sizeof(batch[0]));
+			stream.readUint32Array(batch, count);
+			for (size_t i = 0; i < count; i++) {
+				sum += batch[i];
+			}
+		}
+		g_sink = sum;
+		counters.bytes = stream.pos();
+	} });
+}
+
+static void addMapCases(Runner &runner, const std::shared_ptr<Fixture> &fixture) {
+	auto rifxMovie = std::make_shared<std::unique_ptr<Movie>>();
+	runner.add({ "map/memoryMap", fixture->name, IO::kStageRead,
+		[fixture, rifxMovie]() {
+			*rifxMovie = std::make_unique<Movie>(fixture->rifx);
+			(*rifxMovie)->readHeader();
+		},
+		[rifxMovie](Counters &counters) {
+			DirectorFile *dir = (*rifxMovie)->dir.get();
+			dir->readMemoryMap();
+			counters.bytes = dir->chunkInfo[1].len + dir->chunkInfo[2].len;
+		}
+	});
+
+	// Parses the key table alone, so its entries dominate
+	auto keyMovie = std::make_shared<std::unique_ptr<Movie>>();
+	runner.add({ "map/keyTable", fixture->name, IO::kStageRead,
+		[fixture, keyMovie]() {
+			if (*keyMovie)
+				return;
+			*keyMovie = std::make_unique<Movie>(fixture->rifx);
+			(*keyMovie)->readHeader();
+			(*keyMovie)->dir->readMemoryMap();
+		},
+		[keyMovie](Counters &counters) {
+			DirectorFile *dir = (*keyMovie)->dir.get();
+			int32_t id = dir->getFirstChunkInfo(FOURCC('K', 'E', 'Y', '*'))->id;
+			Common::ReadStream stream(dir->getChunkData(FOURCC('K', 'E', 'Y', '*'), id), dir->endianness);
+			Director::KeyTableChunk keyTable(dir);
+			keyTable.read(stream);
+			g_sink = keyTable.entries.size();
+			counters.bytes = stream.pos();
+			counters.chunks = keyTable.entries.size();
+		}
+	});
+
+	auto abMovie = std::make_shared<std::unique_ptr<Movie>>();
+	runner.add({ "map/afterburnerMap", fixture->name, IO::kStageRead,
+		[fixture, abMovie]() {
+			*abMovie = std::make_unique<Movie>(fixture->afterburner);
+			(*abMovie)->readHeader();
+		},
+		[abMovie](Counters &counters) {
+			Movie &movie = **abMovie;
+			size_t start = movie.stream.pos();
+			if (!movie.dir->readAfterburnerMap())
+				throw std::runtime_error("Could not read Afterburner map");
+			counters.bytes = movie.stream.pos() - start;
+		}
+	});
+}
+
+// Inflates every chunk with the given FourCC, through the same path a
+// decompile takes. The map is read fresh before each iteration so nothing
+// is cached.
+static void addDecompressCase(Runner &runner, const std::shared_ptr<Fixture> &fixture, const std::string &name, uint32_t fourCC) {
+	auto movie = std::make_shared<std::unique_ptr<Movie>>();
+	runner.add({ name, fixture->name, IO::kStageRead,
+		[fixture, movie]() {
+			*movie = std::make_unique<Movie>(fixture->afterburner);
+			(*movie)->readHeader();
+			if (!(*movie)->dir->readAfterburnerMap())
+				throw std::runtime_error("Could not read Afterburner map");
+		},
+		[movie, fourCC](Counters &counters) {
+			DirectorFile *dir = (*movie)->dir.get();
+			for (const auto &id : dir->chunkIDsByFourCC[fourCC]) {
+				dir->getChunkData(fourCC, id);
+				counters.bytes += dir->chunkInfo[id].uncompressedLen;
+				counters.chunks++;
+			}
+		}
+	});
+}
+
+// Many two-frame sounds, like the short effects a game has hundreds of, so
+// the time is dominated by the decoder's per-chunk setup rather than by
+// decoding
+static void addShortSoundCase(Runner &runner, const std::shared_ptr<Fixture> &fixture) {
+	Gen::GeneratorOptions options;
+	options.container = Gen::kContainerAfterburner;
+	options.castCount = fixture->options.castCount;
+	options.scriptsPerCast = 0;
+	options.bitmapsPerCast = 0;
+	options.soundsPerCast = fixture->options.soundsPerCast * 16;
+	options.soundFrames = 2;
+	auto data = std::make_shared<std::vector<uint8_t>>(Gen::Generator(options).build());
+
+	auto movie = std::make_shared<std::unique_ptr<Movie>>();
+	runner.add({ "decompress/snd-short", fixture->name, IO::kStageRead,
+		[data, movie]() {
+			*movie = std::make_unique<Movie>(*data);
+			(*movie)->readHeader();
+			if (!(*movie)->dir->readAfterburnerMap())
+				throw std::runtime_error("Could not read Afterburner map");
+		},
+		[movie](Counters &counters) {
+			DirectorFile *dir = (*movie)->dir.get();
+			uint32_t fourCC = FOURCC('s', 'n', 'd', ' ');
+			for (const auto &id : dir->chunkIDsByFourCC[fourCC]) {
+				dir->getChunkData(fourCC, id);
+				counters.bytes += dir->chunkInfo[id].uncompressedLen;
+				counters.chunks++;
+			}
+		}
+	});
+}
+
+static void addScriptCases(Runner &runner, const std::shared_ptr<Fixture> &fixture) {
+	auto readMovie = std::make_shared<std::unique_ptr<Movie>>();
+	runner.add({ "handler/readData", fixture->name, IO::kStageRead,
+		[fixture, readMovie]() {
+			if (!*readMovie) {
+				*readMovie = std::make_unique<Movie>(fixture->afterburner);
+				(*readMovie)->read();
+			}
+			resetHandlers(**readMovie);
+		},
+		[readMovie](Counters &counters) {
+			readHandlers(**readMovie, counters);
+		}
+	});
+
+	auto namesMovie = std::make_shared<std::unique_ptr<Movie>>();
+	runner.add({ "names/read", fixture->name, IO::kStageRead,
+		[fixture, namesMovie]() {
+			if (!*namesMovie) {
+				*namesMovie = std::make_unique<Movie>(fixture->afterburner);
+				(*namesMovie)->read();
+			}
+		},
+		[namesMovie](Counters &counters) {
+			DirectorFile *dir = (*namesMovie)->dir.get();
+			for (const auto &id : dir->chunkIDsByFourCC[FOURCC('L', 'n', 'a', 'm')]) {
+				Common::ReadStream stream(dir->getChunkData(FOURCC('L', 'n', 'a', 'm'), id));
+				LingoDec::ScriptNames names(dir->version);
+				names.read(stream);
+				counters.bytes += stream.size();
+				g_sink = names.names.size();
+			}
+		}
+	});
+
+	auto parseMovie = std::make_shared<std::unique_ptr<Movie>>();
+	runner.add({ "handler/parse", fixture->name, IO::kStageParse,
+		[fixture, parseMovie]() {
+			if (!*parseMovie) {
+				*parseMovie = std::make_unique<Movie>(fixture->afterburner);
+				(*parseMovie)->read();
+			}
+			resetHandlers(**parseMovie);
+			Counters discarded;
+			readHandlers(**parseMovie, discarded);
+		},
+		[parseMovie](Counters &counters) {
+			for (auto *script : (*parseMovie)->scripts()) {
+				for (auto &handler : script->handlers) {
+					handler->parse();
+					counters.bytes += handler->compiledLen;
+					counters.bytecodes += handler->bytecodeArray.size();
+					counters.handlers++;
+				}
+			}
+		}
+	});
+
+	auto renderMovie = std::make_shared<std::unique_ptr<Movie>>();
+	runner.add({ "ast/render", fixture->name, IO::kStageRestore,
+		[fixture, renderMovie]() {
+			if (!*renderMovie) {
+				*renderMovie = std::make_unique<Movie>(fixture->afterburner);
+				(*renderMovie)->read();
+				(*renderMovie)->dir->parseScripts();
+			}
+		},
+		[renderMovie](Counters &counters) {
+			bool dotSyntax = (*renderMovie)->dir->dotSyntax;
+			for (auto *script : (*renderMovie)->scripts()) {
+				std::string scriptText = script->scriptText("\n", dotSyntax);
+				std::string bytecodeText = script->bytecodeText("\n", dotSyntax);
+				counters.bytes += scriptText.size() + bytecodeText.size();
+				counters.handlers += script->handlers.size();
+			}
+		}
+	});
+}
+
+static void addOutputCases(Runner &runner, const std::shared_ptr<Fixture> &fixture) {
+	auto jsonMovie = std::make_shared<std::unique_ptr<Movie>>();
+	runner.add({ "json/writeChunks", fixture->name, IO::kStageDump,
+		[fixture, jsonMovie]() {
+			if (!*jsonMovie) {
+				*jsonMovie = std::make_unique<Movie>(fixture->afterburner);
+				(*jsonMovie)->read();
+			}
+		},
+		[jsonMovie](Counters &counters) {
+			for (const auto &[id, chunk] : (*jsonMovie)->dir->deserializedChunks) {
+				Common::JSONWriter json("\n");
+				chunk->writeJSON(json);
+				counters.bytes += json.str().size();
+			}
+		}
+	});
+
+	auto writeMovie = std::make_shared<std::unique_ptr<Movie>>();
+	runner.add({ "dirfile/writeToFile", fixture->name, IO::kStageWrite,
+		[fixture, writeMovie]() {
+			if (!*writeMovie) {
+				*writeMovie = std::make_unique<Movie>(fixture->afterburner);
+				(*writeMovie)->read();
+				(*writeMovie)->dir->parseScripts();
+				(*writeMovie)->dir->restoreScriptText();
+			}
+		},
+		[writeMovie](Counters &counters) {
+			DirectorFile *dir = (*writeMovie)->dir.get();
+			dir->writeToFile(scratchPath());
+			counters.bytes = dir->size();
+		}
+	});
+}
+
+void addCases(Runner &runner, const std::shared_ptr<Fixture> &fixture) {
+	addStreamCases(runner, fixture);
+	addMapCases(runner, fixture);
+	addDecompressCase(runner, fixture, "decompress/zlib", FOURCC('B', 'I', 'T', 'D'));
+	addDecompressCase(runner, fixture, "decompress/snd", FOURCC('s', 'n', 'd', ' '));
+	addShortSoundCase(runner, fixture);
+	addScriptCases(runner, fixture);
+	addOutputCases(runner, fixture);
+}
+
+} // namespace Bench
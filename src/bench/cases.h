@@ -0,0 +1,46 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BENCH_CASES_H
+#define BENCH_CASES_H
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gen/generator.h"
+
+namespace Bench {
+
+class Runner;
+
+/* Fixture */
+
+// A generated movie in both container formats
+struct Fixture {
+	std::string name;
+	Gen::GeneratorOptions options;
+	std::vector<uint8_t> rifx;
+	std::vector<uint8_t> afterburner;
+	std::vector<uint8_t> varInts; // the Afterburner movie's words, varint-encoded
+	size_t varIntCount = 0;
+
+	Fixture(const std::string &n, const Gen::GeneratorOptions &o);
+};
+
+std::vector<std::string> fixtureNames();
+std::shared_ptr<Fixture> makeFixture(const std::string &name);
+
+void addCases(Runner &runner, const std::shared_ptr<Fixture> &fixture);
+
+// Scratch file for the writeToFile benchmark
+std::filesystem::path scratchPath();
+
+} // namespace Bench
+
+#endif // BENCH_CASES_H
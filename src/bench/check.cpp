@@ -0,0 +1,104 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/format.hpp>
+
+#include "bench/check.h"
+#include "common/log.h"
+#include "common/stream.h"
+#include "common/util.h"
+#include "director/dirfile.h"
+#include "gen/generator.h"
+
+namespace Bench {
+
+/* sound/skip */
+
+static const unsigned int kSoundFrames = 8;
+static const unsigned int kFrameSamples = 1152;
+
+// The 16-bit mono samples of the single sound in a generated Afterburner
+// movie, decoded through getChunkData
+static std::vector<uint8_t> decodeSound(unsigned int skipSamples) {
+	Gen::GeneratorOptions options;
+	options.container = Gen::kContainerAfterburner;
+	options.scriptsPerCast = 1;
+	options.soundsPerCast = 1;
+	options.soundFrames = kSoundFrames;
+	options.soundSkipSamples = skipSamples;
+	options.soundNoise = true;
+	std::vector<uint8_t> movie = Gen::Generator(options).build();
+
+	Common::ReadStream stream(movie.data(), movie.size());
+	Director::DirectorFile dir;
+	if (!dir.read(&stream))
+		throw std::runtime_error("Could not read generated movie");
+	const auto &ids = dir.chunkIDsByFourCC[FOURCC('s', 'n', 'd', ' ')];
+	if (ids.size() != 1)
+		throw std::runtime_error("Generated movie has no sound");
+
+	Common::BufferView data = dir.getChunkData(FOURCC('s', 'n', 'd', ' '), ids[0]);
+	size_t samplesLen = 2 * (kSoundFrames * kFrameSamples - skipSamples);
+	if (data.size() < samplesLen)
+		throw std::runtime_error("Decoded sound is too short");
+	return std::vector<uint8_t>(data.data() + data.size() - samplesLen, data.data() + data.size());
+}
+
+static bool checkSoundSkip() {
+	std::vector<uint8_t> whole = decodeSound(0);
+	if (std::all_of(whole.begin(), whole.end(), [](uint8_t byte) { return byte == 0; })) {
+		Common::log("sound/skip: the sound decoded to silence");
+		return false;
+	}
+
+	// Skips are discarded through a scratch buffer of one stereo frame,
+	// which holds two mono frames
+	static const unsigned int kSkips[] = {
+		1, 575, 576, 577, 1151, 1152, 1153, 2303, 2304, 2305, 3000, 4608, 5000
+	};
+	bool ok = true;
+	for (unsigned int skip : kSkips) {
+		std::vector<uint8_t> skipped = decodeSound(skip);
+		if (!std::equal(skipped.begin(), skipped.end(), whole.begin() + 2 * skip)) {
+			Common::log(boost::format("sound/skip: skipping %u samples differs from trimming them") % skip);
+			ok = false;
+		}
+	}
+	return ok;
+}
+
+/* runChecks */
+
+size_t runChecks() {
+	struct Check {
+		const char *name;
+		bool (*run)();
+	};
+	static const Check kChecks[] = {
+		{ "sound/skip", checkSoundSkip }
+	};
+
+	size_t failures = 0;
+	for (const Check &check : kChecks) {
+		bool ok;
+		try {
+			ok = check.run();
+		} catch (const std::exception &e) {
+			Common::log(boost::format("%s: %s") % check.name % e.what());
+			ok = false;
+		}
+		Common::log(boost::format("%-40s %s") % check.name % (ok ? "ok" : "FAILED"));
+		if (!ok)
+			failures++;
+	}
+	Common::log(boost::format("\n%zu failures") % failures);
+	return failures;
+}
+
+} // namespace Bench
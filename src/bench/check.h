@@ -0,0 +1,27 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BENCH_CHECK_H
+#define BENCH_CHECK_H
+
+#include <cstddef>
+
+namespace Bench {
+
+/**
+ * Checks that optimized paths give the same output as the plain ones they
+ * replace, on generated movies, and prints a line per check. Returns the
+ * number of failures.
+ *
+ * - sound/skip: an MP3 sound whose leading samples are skipped decodes to
+ *   the same samples as the whole sound with those samples trimmed, for
+ *   skips within, at and across frame and scratch buffer boundaries.
+ */
+size_t runChecks();
+
+} // namespace Bench
+
+#endif // BENCH_CHECK_H
@@ -0,0 +1,257 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include <boost/format.hpp>
+
+#include "bench/compare.h"
+#include "common/jsonreader.h"
+#include "common/log.h"
+#include "io/stats.h"
+
+using Common::JSONValue;
+
+namespace Bench {
+
+/* CompareOptions */
+
+double CompareOptions::thresholdFor(const std::string &name, const std::string &stage) const {
+	double res = threshold;
+	size_t bestLen = 0;
+	for (const auto &[pattern, value] : thresholds) {
+		bool match = (pattern == stage) || (name.compare(0, pattern.size(), pattern) == 0);
+		if (match && pattern.size() >= bestLen) {
+			res = value;
+			bestLen = pattern.size();
+		}
+	}
+	return res;
+}
+
+const char *verdictName(Verdict verdict) {
+	switch (verdict) {
+	case kVerdictUnchanged:
+		return "ok";
+	case kVerdictImproved:
+		return "improved";
+	case kVerdictRegressed:
+		return "REGRESSED";
+	}
+	return "unknown";
+}
+
+/* Statistics */
+
+static double median(std::vector<double> values) {
+	if (values.empty())
+		return 0.0;
+
+	std::sort(values.begin(), values.end());
+	size_t mid = values.size() / 2;
+	if (values.size() % 2 == 0)
+		return (values[mid - 1] + values[mid]) / 2.0;
+	return values[mid];
+}
+
+double mannWhitneyP(const std::vector<double> &baseline, const std::vector<double> &current) {
+	size_t n1 = current.size();
+	size_t n2 = baseline.size();
+	if (n1 == 0 || n2 == 0)
+		return 1.0;
+
+	// Rank the pooled samples, giving ties their average rank
+	std::vector<std::pair<double, bool>> pooled; // (value, is current)
+	for (double val : current) {
+		pooled.emplace_back(val, true);
+	}
+	for (double val : baseline) {
+		pooled.emplace_back(val, false);
+	}
+	std::sort(pooled.begin(), pooled.end());
+
+	size_t n = pooled.size();
+	double currentRankSum = 0.0;
+	double tieTerm = 0.0;
+	size_t i = 0;
+	while (i < n) {
+		size_t j = i;
+		while (j + 1 < n && pooled[j + 1].first == pooled[i].first) {
+			j++;
+		}
+		double rank = (i + j) / 2.0 + 1.0;
+		for (size_t k = i; k <= j; k++) {
+			if (pooled[k].second)
+				currentRankSum += rank;
+		}
+		double t = j - i + 1;
+		tieTerm += t * t * t - t;
+		i = j + 1;
+	}
+
+	double u = currentRankSum - n1 * (n1 + 1) / 2.0;
+	double mean = n1 * n2 / 2.0;
+	double variance = n1 * n2 / 12.0 * ((n + 1) - tieTerm / (n * (n - 1.0)));
+	if (variance <= 0.0)
+		return 1.0; // every sample is identical
+
+	// Continuity correction towards the mean
+	double z = (u - mean - 0.5) / std::sqrt(variance);
+	return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+/* Comparison */
+
+struct Comparison {
+	std::string label;
+	double baselineMedian;
+	double currentMedian;
+	double change; // relative change in the median
+	double p; // one-sided, in the direction of the change
+	double threshold;
+	Verdict verdict;
+};
+
+static Comparison compareSamples(const std::string &label, const std::vector<double> &baseline, const std::vector<double> &current, double threshold, double alpha) {
+	Comparison res;
+	res.label = label;
+	res.baselineMedian = median(baseline);
+	res.currentMedian = median(current);
+	res.change = (res.baselineMedian > 0.0) ? res.currentMedian / res.baselineMedian - 1.0 : 0.0;
+	res.threshold = threshold;
+	res.verdict = kVerdictUnchanged;
+
+	// Only a change that is both large enough and unlikely to be noise counts
+	if (res.change >= 0.0) {
+		res.p = mannWhitneyP(baseline, current);
+		if (res.change > threshold && res.p < alpha)
+			res.verdict = kVerdictRegressed;
+	} else {
+		res.p = mannWhitneyP(current, baseline);
+		if (-res.change > threshold && res.p < alpha)
+			res.verdict = kVerdictImproved;
+	}
+	return res;
+}
+
+static void logComparison(const Comparison &comparison) {
+	Common::log(boost::format("%-40s %12.3f us %12.3f us %+8.1f%%  p=%.4f  (%.0f%%)  %s")
+		% comparison.label
+		% (comparison.baselineMedian * 1e6) % (comparison.currentMedian * 1e6)
+		% (comparison.change * 100.0) % comparison.p % (comparison.threshold * 100.0)
+		% verdictName(comparison.verdict));
+}
+
+struct BenchmarkSamples {
+	std::string stage;
+	std::vector<double> samples;
+};
+
+static std::string benchmarkKey(const JSONValue &benchmark) {
+	return benchmark["name"].asString() + "/" + benchmark["fixture"].asString();
+}
+
+static std::map<std::string, BenchmarkSamples> readBenchmarks(const JSONValue &results, std::vector<std::string> *order) {
+	std::map<std::string, BenchmarkSamples> res;
+	for (const auto &benchmark : results["benchmarks"].asArray()) {
+		std::string key = benchmarkKey(benchmark);
+		BenchmarkSamples &entry = res[key];
+		entry.stage = benchmark["stage"].asString();
+		for (const auto &sample : benchmark["samples"].asArray()) {
+			entry.samples.push_back(sample.asNumber());
+		}
+		if (order)
+			order->push_back(key);
+	}
+	return res;
+}
+
+// Stage totals per fixture. Sample i of a stage is the sum of sample i of
+// every benchmark in it, so the test sees the stage's combined variance.
+static void addToStage(std::vector<double> &stageSamples, const std::vector<double> &samples) {
+	if (stageSamples.empty()) {
+		stageSamples = samples;
+		return;
+	}
+	stageSamples.resize(std::min(stageSamples.size(), samples.size()));
+	for (size_t i = 0; i < stageSamples.size(); i++) {
+		stageSamples[i] += samples[i];
+	}
+}
+
+size_t compareResults(const JSONValue &baseline, const JSONValue &current, const CompareOptions &options) {
+	std::vector<std::string> order;
+	auto baselineBenchmarks = readBenchmarks(baseline, nullptr);
+	auto currentBenchmarks = readBenchmarks(current, &order);
+
+	if (baseline.has("gitSha") && current.has("gitSha")) {
+		Common::log(boost::format("Comparing %s (baseline) to %s")
+			% baseline["gitSha"].asString() % current["gitSha"].asString());
+	}
+
+	size_t regressions = 0;
+	size_t improvements = 0;
+
+	// (fixture, stage) -> samples
+	std::map<std::pair<std::string, std::string>, std::vector<double>> baselineStages;
+	std::map<std::pair<std::string, std::string>, std::vector<double>> currentStages;
+	std::vector<std::string> fixtures;
+
+	Common::log("\nBenchmarks:");
+	for (const auto &key : order) {
+		const BenchmarkSamples &cur = currentBenchmarks[key];
+		auto it = baselineBenchmarks.find(key);
+		if (it == baselineBenchmarks.end()) {
+			Common::log(boost::format("%-40s not in baseline") % key);
+			continue;
+		}
+		const BenchmarkSamples &base = it->second;
+
+		Comparison comparison = compareSamples(key, base.samples, cur.samples,
+			options.thresholdFor(key, cur.stage), options.alpha);
+		logComparison(comparison);
+		if (comparison.verdict == kVerdictRegressed)
+			regressions++;
+		else if (comparison.verdict == kVerdictImproved)
+			improvements++;
+
+		std::string fixture = key.substr(key.rfind('/') + 1);
+		if (std::find(fixtures.begin(), fixtures.end(), fixture) == fixtures.end())
+			fixtures.push_back(fixture);
+		addToStage(baselineStages[{ fixture, cur.stage }], base.samples);
+		addToStage(currentStages[{ fixture, cur.stage }], cur.samples);
+	}
+	for (const auto &[key, base] : baselineBenchmarks) {
+		if (currentBenchmarks.find(key) == currentBenchmarks.end())
+			Common::log(boost::format("%-40s missing from current results") % key);
+	}
+
+	Common::log("\nStages:");
+	for (const auto &fixture : fixtures) {
+		for (int stage = 0; stage < IO::kStageCount; stage++) {
+			std::string stageName = IO::stageName((IO::Stage)stage);
+			auto stageKey = std::make_pair(fixture, stageName);
+			if (currentStages.find(stageKey) == currentStages.end())
+				continue;
+
+			Comparison comparison = compareSamples(stageName + "/" + fixture,
+				baselineStages[stageKey], currentStages[stageKey],
+				options.thresholdFor(stageName, stageName), options.alpha);
+			logComparison(comparison);
+			if (comparison.verdict == kVerdictRegressed)
+				regressions++;
+			else if (comparison.verdict == kVerdictImproved)
+				improvements++;
+		}
+	}
+
+	Common::log(boost::format("\n%zu regressions, %zu improvements") % regressions % improvements);
+	return regressions;
+}
+
+} // namespace Bench
@@ -0,0 +1,52 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BENCH_COMPARE_H
+#define BENCH_COMPARE_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Common {
+struct JSONValue;
+}
+
+namespace Bench {
+
+struct CompareOptions {
+	double alpha = 0.05; // significance level
+	double threshold = 0.05; // smallest relative change in the median that counts
+
+	// Overrides as (pattern, threshold). A pattern matches a stage name, or
+	// a prefix of "benchmark/fixture". The longest matching pattern wins.
+	std::vector<std::pair<std::string, double>> thresholds;
+
+	double thresholdFor(const std::string &name, const std::string &stage) const;
+};
+
+enum Verdict {
+	kVerdictUnchanged,
+	kVerdictImproved,
+	kVerdictRegressed
+};
+
+const char *verdictName(Verdict verdict);
+
+// One-sided Mann-Whitney U test, using the normal approximation with tie
+// correction. Returns the p-value for "current is slower than baseline".
+double mannWhitneyP(const std::vector<double> &baseline, const std::vector<double> &current);
+
+/**
+ * Compares two result sets written by projectorrays-bench --output, both
+ * per benchmark and per pipeline stage, and prints a report. Returns the
+ * number of regressions.
+ */
+size_t compareResults(const Common::JSONValue &baseline, const Common::JSONValue &current, const CompareOptions &options);
+
+} // namespace Bench
+
+#endif // BENCH_COMPARE_H
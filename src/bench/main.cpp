@@ -0,0 +1,189 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bench/bench.h"
+#include "bench/cases.h"
+#include "bench/check.h"
+#include "bench/compare.h"
+#include "common/jsonreader.h"
+#include "common/json.h"
+#include "common/log.h"
+
+namespace fs = std::filesystem;
+
+static void printUsage(const char *programName) {
+	std::cout << "Usage: " << programName << " [options]\n"
+		<< "       " << programName << " compare [options] BASELINE CURRENT\n"
+		<< "       " << programName << " check\n"
+		<< "Benchmarks ProjectorRays' pipeline stages on generated movies.\n"
+		<< "\n"
+		<< "Options:\n"
+		<< "  --output FILE          Write results as JSON to FILE\n"
+		<< "  --filter TEXT          Only run benchmarks whose name/fixture contains TEXT\n"
+		<< "  --fixtures LIST        Comma-separated fixture sizes (default: small,medium,large)\n"
+		<< "  --samples N            Samples per benchmark (default: 10)\n"
+		<< "  --min-time SECONDS     Minimum duration of each sample (default: 0.05)\n"
+		<< "  --quick                Small fixture, 5 samples of at least 0.01 seconds\n"
+		<< "\n"
+		<< "Compare options:\n"
+		<< "  --threshold PERCENT    Smallest change in a median that counts (default: 5)\n"
+		<< "  --threshold PATTERN=PERCENT\n"
+		<< "                         Threshold for a stage, or for benchmarks starting with PATTERN\n"
+		<< "  --alpha P              Significance level of the Mann-Whitney U test (default: 0.05)\n"
+		<< "\n"
+		<< "compare exits with status 1 if any benchmark or stage regressed, 2 on errors.\n"
+		<< "check verifies optimized paths against plain ones and exits with status 1 on a mismatch.\n";
+}
+
+static std::vector<std::string> splitList(const std::string &list) {
+	std::vector<std::string> res;
+	size_t start = 0;
+	while (start <= list.size()) {
+		size_t end = list.find(',', start);
+		if (end == std::string::npos)
+			end = list.size();
+		if (end > start)
+			res.push_back(list.substr(start, end - start));
+		start = end + 1;
+	}
+	return res;
+}
+
+static std::string readTextFile(const std::string &path) {
+	std::ifstream in(path, std::ios::binary);
+	if (!in)
+		throw std::runtime_error("Could not open " + path);
+	std::ostringstream ss;
+	ss << in.rdbuf();
+	return ss.str();
+}
+
+static int compareMain(int argc, char *argv[]) {
+	Bench::CompareOptions options;
+	std::vector<std::string> paths;
+
+	try {
+		for (int i = 2; i < argc; i++) {
+			std::string arg = argv[i];
+			if (arg.rfind("--", 0) != 0) {
+				paths.push_back(arg);
+				continue;
+			}
+			if (i + 1 >= argc)
+				throw std::runtime_error("Option " + arg + " expects an argument");
+
+			std::string val = argv[++i];
+			if (arg == "--threshold") {
+				size_t eq = val.rfind('=');
+				if (eq == std::string::npos) {
+					options.threshold = std::stod(val) / 100.0;
+				} else {
+					options.thresholds.emplace_back(val.substr(0, eq), std::stod(val.substr(eq + 1)) / 100.0);
+				}
+			} else if (arg == "--alpha") {
+				options.alpha = std::stod(val);
+			} else {
+				throw std::runtime_error("Unknown option " + arg);
+			}
+		}
+		if (paths.size() != 2) {
+			printUsage(argv[0]);
+			return 2;
+		}
+
+		Common::JSONValue baseline = Common::parseJSON(readTextFile(paths[0]));
+		Common::JSONValue current = Common::parseJSON(readTextFile(paths[1]));
+		if (Bench::compareResults(baseline, current, options) > 0)
+			return 1;
+	} catch (const std::exception &e) {
+		Common::warning(e.what());
+		return 2;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc > 1 && std::string(argv[1]) == "compare")
+		return compareMain(argc, argv);
+	if (argc > 1 && std::string(argv[1]) == "check")
+		return (Bench::runChecks() == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+	Bench::RunnerOptions options;
+	std::vector<std::string> fixtures = Bench::fixtureNames();
+	std::string output;
+
+	try {
+		for (int i = 1; i < argc; i++) {
+			std::string arg = argv[i];
+			if (arg == "-h" || arg == "--help") {
+				printUsage(argv[0]);
+				return EXIT_SUCCESS;
+			}
+			if (arg == "--quick") {
+				fixtures = { "small" };
+				options.samples = 5;
+				options.minSampleTime = 0.01;
+				continue;
+			}
+			if (i + 1 >= argc)
+				throw std::runtime_error("Option " + arg + " expects an argument");
+
+			std::string val = argv[++i];
+			if (arg == "--output") {
+				output = val;
+			} else if (arg == "--filter") {
+				options.filter = val;
+			} else if (arg == "--fixtures") {
+				fixtures = splitList(val);
+			} else if (arg == "--samples") {
+				options.samples = std::stoul(val);
+				if (options.samples == 0)
+					throw std::runtime_error("--samples must be at least 1");
+			} else if (arg == "--min-time") {
+				options.minSampleTime = std::stod(val);
+			} else {
+				throw std::runtime_error("Unknown option " + arg);
+			}
+		}
+
+		Bench::Runner runner(options);
+		for (const auto &name : fixtures) {
+			auto fixture = Bench::makeFixture(name);
+			Common::log(boost::format("Fixture %s: %zu bytes RIFX, %zu bytes Afterburner")
+				% name % fixture->rifx.size() % fixture->afterburner.size());
+			Bench::addCases(runner, fixture);
+		}
+
+		std::vector<Bench::Result> results = runner.runAll();
+		fs::remove(Bench::scratchPath());
+
+		if (!output.empty()) {
+			Common::JSONWriter json("\n");
+			Bench::writeResultsJSON(json, options, results);
+			std::ofstream out(output, std::ios::binary);
+			out << json.str();
+			out.close();
+			if (!out)
+				throw std::runtime_error("Could not write " + output);
+			Common::log("Wrote " + output);
+		}
+	} catch (const std::exception &e) {
+		Common::warning(e.what());
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "common/hash.h"
+
+namespace Common {
+
+std::string Hash128::toString() const {
+	static const char *digits = "0123456789abcdef";
+	std::string str(32, '0');
+	for (int i = 0; i < 16; i++) {
+		str[15 - i] = digits[(h1 >> (4 * i)) & 0xF];
+		str[31 - i] = digits[(h2 >> (4 * i)) & 0xF];
+	}
+	return str;
+}
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+	return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t fmix64(uint64_t k) {
+	k ^= k >> 33;
+	k *= 0xff51afd7ed558ccdULL;
+	k ^= k >> 33;
+	k *= 0xc4ceb9fe1a85ec53ULL;
+	k ^= k >> 33;
+	return k;
+}
+
+// Blocks are read as little endian so the hash is the same on every host
+static inline uint64_t readBlock(const uint8_t *p) {
+	uint64_t k = 0;
+	for (int i = 7; i >= 0; i--) {
+		k = (k << 8) | p[i];
+	}
+	return k;
+}
+
+Hash128 murmurHash3(const void *data, size_t len, uint32_t seed) {
+	const uint8_t *bytes = static_cast<const uint8_t *>(data);
+	const size_t blockCount = len / 16;
+	const uint64_t c1 = 0x87c37b91114253d5ULL;
+	const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+	uint64_t h1 = seed;
+	uint64_t h2 = seed;
+
+	for (size_t i = 0; i < blockCount; i++) {
+		uint64_t k1 = readBlock(bytes + i * 16);
+		uint64_t k2 = readBlock(bytes + i * 16 + 8);
+
+		k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+		h1 = rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+		k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+		h2 = rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+	}
+
+	const uint8_t *tail = bytes + blockCount * 16;
+	uint64_t k1 = 0;
+	uint64_t k2 = 0;
+	switch (len & 15) {
+	case 15: k2 ^= (uint64_t)tail[14] << 48; [[fallthrough]];
+	case 14: k2 ^= (uint64_t)tail[13] << 40; [[fallthrough]];
+	case 13: k2 ^= (uint64_t)tail[12] << 32; [[fallthrough]];
+	case 12: k2 ^= (uint64_t)tail[11] << 24; [[fallthrough]];
+	case 11: k2 ^= (uint64_t)tail[10] << 16; [[fallthrough]];
+	case 10: k2 ^= (uint64_t)tail[9] << 8; [[fallthrough]];
+	case 9:
+		k2 ^= (uint64_t)tail[8];
+		k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+		[[fallthrough]];
+	case 8: k1 ^= (uint64_t)tail[7] << 56; [[fallthrough]];
+	case 7: k1 ^= (uint64_t)tail[6] << 48; [[fallthrough]];
+	case 6: k1 ^= (uint64_t)tail[5] << 40; [[fallthrough]];
+	case 5: k1 ^= (uint64_t)tail[4] << 32; [[fallthrough]];
+	case 4: k1 ^= (uint64_t)tail[3] << 24; [[fallthrough]];
+	case 3: k1 ^= (uint64_t)tail[2] << 16; [[fallthrough]];
+	case 2: k1 ^= (uint64_t)tail[1] << 8; [[fallthrough]];
+	case 1:
+		k1 ^= (uint64_t)tail[0];
+		k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+		break;
+	default:
+		break;
+	}
+
+	h1 ^= len;
+	h2 ^= len;
+	h1 += h2;
+	h2 += h1;
+	h1 = fmix64(h1);
+	h2 = fmix64(h2);
+	h1 += h2;
+	h2 += h1;
+
+	Hash128 hash;
+	hash.h1 = h1;
+	hash.h2 = h2;
+	return hash;
+}
+
+} // namespace Common
@@ -0,0 +1,31 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COMMON_HASH_H
+#define COMMON_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Common {
+
+struct Hash128 {
+	uint64_t h1 = 0;
+	uint64_t h2 = 0;
+
+	bool operator==(const Hash128 &other) const { return h1 == other.h1 && h2 == other.h2; }
+	bool operator!=(const Hash128 &other) const { return !(*this == other); }
+	std::string toString() const;
+};
+
+// MurmurHash3 x64 128-bit. Not cryptographic, but wide enough that
+// accidental collisions between content keys aren't a concern.
+Hash128 murmurHash3(const void *data, size_t len, uint32_t seed = 0);
+
+} // namespace Common
+
+#endif // COMMON_HASH_H
@@ -9,9 +9,84 @@
 
 namespace Common {
 
+// Length of the well-formed UTF-8 sequence at the start of s, or 0 if there
+// isn't one
+static size_t utf8SequenceLength(const unsigned char *s, size_t size) {
+	size_t len;
+	if (s[0] >= 0xC2 && s[0] <= 0xDF) {
+		len = 2;
+	} else if (s[0] >= 0xE0 && s[0] <= 0xEF) {
+		len = 3;
+	} else if (s[0] >= 0xF0 && s[0] <= 0xF4) {
+		len = 4;
+	} else {
+		return 0;
+	}
+	if (len > size)
+		return 0;
+	for (size_t i = 1; i < len; i++) {
+		if ((s[i] & 0xC0) != 0x80)
+			return 0;
+	}
+	// Overlong forms, surrogates, and code points past U+10FFFF
+	if ((s[0] == 0xE0 && s[1] < 0xA0) || (s[0] == 0xED && s[1] >= 0xA0)
+			|| (s[0] == 0xF0 && s[1] < 0x90) || (s[0] == 0xF4 && s[1] >= 0x90))
+		return 0;
+	return len;
+}
+
+static std::string escapeStrictJSON(const std::string &str) {
+	std::string res;
+	const unsigned char *s = reinterpret_cast<const unsigned char *>(str.data());
+	size_t i = 0;
+	while (i < str.size()) {
+		unsigned char ch = s[i];
+		if (ch >= 0x80) {
+			size_t len = utf8SequenceLength(s + i, str.size() - i);
+			if (len != 0) {
+				res.append(str, i, len);
+				i += len;
+				continue;
+			}
+		}
+		switch (ch) {
+		case '"':
+			res += "\\\"";
+			break;
+		case '\\':
+			res += "\\\\";
+			break;
+		case '\b':
+			res += "\\b";
+			break;
+		case '\f':
+			res += "\\f";
+			break;
+		case '\n':
+			res += "\\n";
+			break;
+		case '\r':
+			res += "\\r";
+			break;
+		case '\t':
+			res += "\\t";
+			break;
+		default:
+			if (ch < 0x20 || ch >= 0x80) {
+				res += "\\u00" + byteToString(ch);
+			} else {
+				res += ch;
+			}
+			break;
+		}
+		i++;
+	}
+	return res;
+}
+
 void JSONWriter::writeString(std::string str) {
 	write("\"");
-	write(escapeString(str));
+	write((_dialect == kJSONStrict) ? escapeStrictJSON(str) : escapeString(str));
 	write("\"");
 }
 
@@ -87,6 +162,13 @@ void JSONWriter::writeVal(int val) {
 	writeValueSuffix();
 }
 
+void JSONWriter::writeVal(uint64_t val) {
+	writeValuePrefix();
+	write(std::to_string(val));
+	_context = kContextValue;
+	writeValueSuffix();
+}
+
 void JSONWriter::writeVal(double val) {
 	writeValuePrefix();
 	write(floatToString(val));
@@ -94,6 +176,17 @@ void JSONWriter::writeVal(double val) {
 	writeValueSuffix();
 }
 
+void JSONWriter::writeVal(bool val) {
+	writeValuePrefix();
+	write(val ? "true" : "false");
+	_context = kContextValue;
+	writeValueSuffix();
+}
+
+void JSONWriter::writeVal(const char *val) {
+	writeVal(std::string(val));
+}
+
 void JSONWriter::writeVal(std::string val) {
 	writeValuePrefix();
 	writeString(val);
@@ -111,7 +204,7 @@ void JSONWriter::writeNull() {
 void JSONWriter::writeFourCC(uint32_t val) {
 	writeValuePrefix();
 	write("\"");
-	write(fourCCToString(val));
+	write((_dialect == kJSONStrict) ? escapeStrictJSON(rawFourCC(val)) : fourCCToString(val));
 	write("\"");
 	_context = kContextValue;
 	writeValueSuffix();
@@ -127,11 +220,26 @@ void JSONWriter::writeField(std::string key, int val) {
 	writeVal(val);
 }
 
+void JSONWriter::writeField(std::string key, uint64_t val) {
+	writeKey(key);
+	writeVal(val);
+}
+
 void JSONWriter::writeField(std::string key, double val) {
 	writeKey(key);
 	writeVal(val);
 }
 
+void JSONWriter::writeField(std::string key, bool val) {
+	writeKey(key);
+	writeVal(val);
+}
+
+void JSONWriter::writeField(std::string key, const char *val) {
+	writeKey(key);
+	writeVal(val);
+}
+
 void JSONWriter::writeField(std::string key, std::string val) {
 	writeKey(key);
 	writeVal(val);
@@ -22,8 +22,18 @@ namespace Common {
  * - Printable ASCII characters without corresponding single-character escape
  *   sequences
  * - The non-standard hex code escape sequence \xXX
+ *
+ * Output read by other programs should use kJSONStrict instead, which writes
+ * standard JSON: other control characters are escaped as \u00XX, and valid
+ * UTF-8 is passed through. A byte which isn't part of valid UTF-8 is escaped
+ * as \u00XX too, so it reads back as the Latin-1 character with that code.
  */
 
+enum JSONDialect {
+	kJSONExtended,
+	kJSONStrict
+};
+
 class JSONWriter : protected CodeWriter {
 protected:
 	enum Context {
@@ -34,10 +44,11 @@ protected:
 	};
 
 	Context _context = kContextStart;
+	JSONDialect _dialect;
 
 public:
-	JSONWriter(std::string lineEnding, std::string indentation = "  ")
-		: CodeWriter(lineEnding, indentation) {}
+	JSONWriter(std::string lineEnding, std::string indentation = "  ", JSONDialect dialect = kJSONExtended)
+		: CodeWriter(lineEnding, indentation), _dialect(dialect) {}
 
 	void startObject();
 	void writeKey(std::string key);
@@ -48,14 +59,20 @@ public:
 
 	void writeVal(unsigned int val);
 	void writeVal(int val);
+	void writeVal(uint64_t val);
 	void writeVal(double val);
+	void writeVal(bool val);
+	void writeVal(const char *val);
 	void writeVal(std::string val);
 	void writeNull();
 	void writeFourCC(uint32_t val);
 
 	void writeField(std::string key, unsigned int val);
 	void writeField(std::string key, int val);
+	void writeField(std::string key, uint64_t val);
 	void writeField(std::string key, double val);
+	void writeField(std::string key, bool val);
+	void writeField(std::string key, const char *val);
 	void writeField(std::string key, std::string val);
 	void writeNullField(std::string key);
 	void writeFourCCField(std::string key, uint32_t val);
@@ -0,0 +1,259 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstdlib>
+#include <stdexcept>
+
+#include "common/jsonreader.h"
+
+namespace Common {
+
+/* JSONValue */
+
+bool JSONValue::has(const std::string &key) const {
+	return type == kObject && object.find(key) != object.end();
+}
+
+const JSONValue &JSONValue::operator[](const std::string &key) const {
+	if (type != kObject)
+		throw std::runtime_error("JSON: Expected an object with key '" + key + "'");
+
+	auto it = object.find(key);
+	if (it == object.end())
+		throw std::runtime_error("JSON: Missing key '" + key + "'");
+	return it->second;
+}
+
+double JSONValue::asNumber() const {
+	if (type != kNumber)
+		throw std::runtime_error("JSON: Expected a number");
+	return number;
+}
+
+const std::string &JSONValue::asString() const {
+	if (type != kString)
+		throw std::runtime_error("JSON: Expected a string");
+	return string;
+}
+
+const std::vector<JSONValue> &JSONValue::asArray() const {
+	if (type != kArray)
+		throw std::runtime_error("JSON: Expected an array");
+	return array;
+}
+
+/* Parser */
+
+class JSONParser {
+private:
+	const std::string &_text;
+	size_t _pos = 0;
+
+	[[noreturn]] void error(const std::string &msg) {
+		throw std::runtime_error("JSON: " + msg + " at offset " + std::to_string(_pos));
+	}
+
+	void skipWhitespace() {
+		while (_pos < _text.size() && (_text[_pos] == ' ' || _text[_pos] == '\t' || _text[_pos] == '\n' || _text[_pos] == '\r')) {
+			_pos++;
+		}
+	}
+
+	char peek() {
+		skipWhitespace();
+		if (_pos >= _text.size())
+			error("Unexpected end of input");
+		return _text[_pos];
+	}
+
+	void expect(char c) {
+		if (peek() != c)
+			error(std::string("Expected '") + c + "'");
+		_pos++;
+	}
+
+	void expectWord(const char *word) {
+		for (const char *p = word; *p; p++) {
+			if (_pos >= _text.size() || _text[_pos] != *p)
+				error(std::string("Expected '") + word + "'");
+			_pos++;
+		}
+	}
+
+	unsigned int readHex(size_t digits) {
+		if (_pos + digits > _text.size())
+			error("Truncated escape sequence");
+
+		unsigned int res = 0;
+		for (size_t i = 0; i < digits; i++) {
+			char c = _text[_pos++];
+			res <<= 4;
+			if (c >= '0' && c <= '9') {
+				res |= c - '0';
+			} else if (c >= 'a' && c <= 'f') {
+				res |= c - 'a' + 10;
+			} else if (c >= 'A' && c <= 'F') {
+				res |= c - 'A' + 10;
+			} else {
+				error("Invalid hex digit");
+			}
+		}
+		return res;
+	}
+
+	void appendUTF8(std::string &res, unsigned int codePoint) {
+		if (codePoint < 0x80) {
+			res += (char)codePoint;
+		} else if (codePoint < 0x800) {
+			res += (char)(0xC0 | (codePoint >> 6));
+			res += (char)(0x80 | (codePoint & 0x3F));
+		} else {
+			res += (char)(0xE0 | (codePoint >> 12));
+			res += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+			res += (char)(0x80 | (codePoint & 0x3F));
+		}
+	}
+
+	std::string parseString() {
+		expect('"');
+		std::string res;
+		while (true) {
+			if (_pos >= _text.size())
+				error("Unterminated string");
+
+			char c = _text[_pos++];
+			if (c == '"')
+				break;
+			if (c != '\\') {
+				res += c;
+				continue;
+			}
+
+			if (_pos >= _text.size())
+				error("Unterminated string");
+			char esc = _text[_pos++];
+			switch (esc) {
+			case '"':
+			case '\\':
+			case '/':
+				res += esc;
+				break;
+			case 'b':
+				res += '\b';
+				break;
+			case 'f':
+				res += '\f';
+				break;
+			case 'n':
+				res += '\n';
+				break;
+			case 'r':
+				res += '\r';
+				break;
+			case 't':
+				res += '\t';
+				break;
+			case 'v':
+				res += '\v';
+				break;
+			case 'x':
+				res += (char)readHex(2);
+				break;
+			case 'u':
+				appendUTF8(res, readHex(4));
+				break;
+			default:
+				error(std::string("Invalid escape sequence \\") + esc);
+			}
+		}
+		return res;
+	}
+
+	double parseNumber() {
+		const char *start = _text.c_str() + _pos;
+		char *end;
+		double res = std::strtod(start, &end);
+		if (end == start)
+			error("Invalid number");
+		_pos += end - start;
+		return res;
+	}
+
+public:
+	JSONParser(const std::string &text) : _text(text) {}
+
+	JSONValue parseValue() {
+		JSONValue res;
+		char c = peek();
+		if (c == '{') {
+			res.type = JSONValue::kObject;
+			_pos++;
+			if (peek() == '}') {
+				_pos++;
+				return res;
+			}
+			while (true) {
+				std::string key = parseString();
+				expect(':');
+				res.object[key] = parseValue();
+				if (peek() == ',') {
+					_pos++;
+					continue;
+				}
+				expect('}');
+				break;
+			}
+		} else if (c == '[') {
+			res.type = JSONValue::kArray;
+			_pos++;
+			if (peek() == ']') {
+				_pos++;
+				return res;
+			}
+			while (true) {
+				res.array.push_back(parseValue());
+				if (peek() == ',') {
+					_pos++;
+					continue;
+				}
+				expect(']');
+				break;
+			}
+		} else if (c == '"') {
+			res.type = JSONValue::kString;
+			res.string = parseString();
+		} else if (c == 't') {
+			expectWord("true");
+			res.type = JSONValue::kBool;
+			res.boolVal = true;
+		} else if (c == 'f') {
+			expectWord("false");
+			res.type = JSONValue::kBool;
+			res.boolVal = false;
+		} else if (c == 'n') {
+			expectWord("null");
+		} else {
+			res.type = JSONValue::kNumber;
+			res.number = parseNumber();
+		}
+		return res;
+	}
+
+	void expectEnd() {
+		skipWhitespace();
+		if (_pos != _text.size())
+			error("Unexpected trailing data");
+	}
+};
+
+JSONValue parseJSON(const std::string &text) {
+	JSONParser parser(text);
+	JSONValue res = parser.parseValue();
+	parser.expectEnd();
+	return res;
+}
+
+} // namespace Common
@@ -0,0 +1,51 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COMMON_JSONREADER_H
+#define COMMON_JSONREADER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Common {
+
+/**
+ * JSONValue is a parsed JSON document. The parser accepts everything
+ * Common::JSONWriter produces, including its non-standard \v and \xXX
+ * string escapes.
+ */
+
+struct JSONValue {
+	enum Type {
+		kNull,
+		kBool,
+		kNumber,
+		kString,
+		kArray,
+		kObject
+	};
+
+	Type type = kNull;
+	bool boolVal = false;
+	double number = 0.0;
+	std::string string;
+	std::vector<JSONValue> array;
+	std::map<std::string, JSONValue> object;
+
+	bool has(const std::string &key) const;
+	const JSONValue &operator[](const std::string &key) const;
+
+	double asNumber() const;
+	const std::string &asString() const;
+	const std::vector<JSONValue> &asArray() const;
+};
+
+JSONValue parseJSON(const std::string &text);
+
+} // namespace Common
+
+#endif // COMMON_JSONREADER_H
@@ -12,11 +12,25 @@ namespace Common {
 
 bool g_verbose = false;
 
+static thread_local LogHandler t_logHandler;
+
+void setThreadLogHandler(LogHandler handler) {
+	t_logHandler = std::move(handler);
+}
+
 void log(const std::string &msg) {
+	if (t_logHandler) {
+		t_logHandler(false, msg);
+		return;
+	}
 	std::cout << msg << "\n";
 }
 
 void log(const boost::format &msg) {
+	if (t_logHandler) {
+		t_logHandler(false, msg.str());
+		return;
+	}
 	std::cout << msg << "\n";
 }
 
@@ -31,10 +45,18 @@ void debug(const boost::format &msg) {
 }
 
 void warning(const std::string &msg) {
+	if (t_logHandler) {
+		t_logHandler(true, msg);
+		return;
+	}
 	std::cerr << msg << "\n";
 }
 
 void warning(const boost::format &msg) {
+	if (t_logHandler) {
+		t_logHandler(true, msg.str());
+		return;
+	}
 	std::cerr << msg << "\n";
 }
 
@@ -7,6 +7,7 @@
 #ifndef COMMON_LOG_H
 #define COMMON_LOG_H
 
+#include <functional>
 #include <string>
 #include <boost/format.hpp>
 
@@ -14,6 +15,12 @@ namespace Common {
 
 extern bool g_verbose;
 
+// Receives the messages logged on one thread instead of stdout and stderr
+typedef std::function<void(bool isWarning, const std::string &msg)> LogHandler;
+
+// Sets the calling thread's handler, or restores the default if it is empty
+void setThreadLogHandler(LogHandler handler);
+
 void log(const std::string &msg);
 void log(const boost::format &msg);
 void debug(const std::string &msg);
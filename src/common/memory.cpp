@@ -0,0 +1,65 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "common/json.h"
+#include "common/memory.h"
+
+namespace Common {
+
+const char *memoryCategoryName(MemoryCategory category) {
+	switch (category) {
+	case kMemoryILS:
+		return "ils";
+	case kMemoryInflatedChunks:
+		return "inflatedChunks";
+	case kMemoryDecodedSound:
+		return "decodedSound";
+	case kMemoryAST:
+		return "ast";
+	case kMemoryRenderedText:
+		return "renderedText";
+	default:
+		break;
+	}
+	return "unknown";
+}
+
+/* MemoryTracker */
+
+void MemoryTracker::allocate(MemoryCategory category, size_t bytes) {
+	_live[category] += bytes;
+	if (_live[category] > _peak[category]) {
+		_peak[category] = _live[category];
+	}
+	_liveTotal += bytes;
+	if (_liveTotal > _peakTotal) {
+		_peakTotal = _liveTotal;
+	}
+}
+
+void MemoryTracker::release(MemoryCategory category, size_t bytes) {
+	if (bytes > _live[category]) {
+		bytes = _live[category];
+	}
+	_live[category] -= bytes;
+	_liveTotal -= bytes;
+}
+
+void MemoryTracker::writeJSON(JSONWriter &json) const {
+	json.startObject();
+		for (int category = 0; category < kMemoryCategoryCount; category++) {
+			json.writeKey(memoryCategoryName((MemoryCategory)category));
+			json.startObject();
+				json.writeField("live", (uint64_t)_live[category]);
+				json.writeField("peak", (uint64_t)_peak[category]);
+			json.endObject();
+		}
+		json.writeField("liveTotal", (uint64_t)_liveTotal);
+		json.writeField("peakTotal", (uint64_t)_peakTotal);
+	json.endObject();
+}
+
+} // namespace Common
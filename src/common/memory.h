@@ -0,0 +1,55 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef COMMON_MEMORY_H
+#define COMMON_MEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Common {
+
+class JSONWriter;
+
+enum MemoryCategory {
+	kMemoryILS,
+	kMemoryInflatedChunks,
+	kMemoryDecodedSound,
+	kMemoryAST,
+	kMemoryRenderedText,
+	kMemoryCategoryCount
+};
+
+const char *memoryCategoryName(MemoryCategory category);
+
+/**
+ * MemoryTracker keeps live and peak byte counts for the buffers a
+ * DirectorFile holds on to. It only does bookkeeping; owners report their
+ * own allocations and releases.
+ */
+
+class MemoryTracker {
+private:
+	size_t _live[kMemoryCategoryCount] = {};
+	size_t _peak[kMemoryCategoryCount] = {};
+	size_t _liveTotal = 0;
+	size_t _peakTotal = 0;
+
+public:
+	void allocate(MemoryCategory category, size_t bytes);
+	void release(MemoryCategory category, size_t bytes);
+
+	size_t live(MemoryCategory category) const { return _live[category]; }
+	size_t peak(MemoryCategory category) const { return _peak[category]; }
+	size_t liveTotal() const { return _liveTotal; }
+	size_t peakTotal() const { return _peakTotal; }
+
+	void writeJSON(JSONWriter &json) const;
+};
+
+} // namespace Common
+
+#endif // COMMON_MEMORY_H
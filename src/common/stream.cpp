@@ -4,15 +4,68 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include <algorithm>
+
 #include <boost/format.hpp>
 #include <boost/endian/conversion.hpp>
 #include <zlib.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "common/log.h"
 #include "common/stream.h"
 
 namespace Common {
 
+void swapBytes16(uint8_t *data, size_t size) {
+	size_t i = 0;
+#if defined(__SSE2__)
+	for (; i + 16 <= size; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(data + i));
+		v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+		_mm_storeu_si128((__m128i *)(data + i), v);
+	}
+#elif defined(__ARM_NEON)
+	for (; i + 16 <= size; i += 16) {
+		vst1q_u8(data + i, vrev16q_u8(vld1q_u8(data + i)));
+	}
+#endif
+	for (; i + 2 <= size; i += 2) {
+		uint8_t b = data[i];
+		data[i] = data[i + 1];
+		data[i + 1] = b;
+	}
+}
+
+void swapBytes32(uint8_t *data, size_t size) {
+	size_t i = 0;
+#if defined(__SSE2__)
+	for (; i + 16 <= size; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(data + i));
+		// swap the bytes of each half, then the halves
+		v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+		v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+		v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+		_mm_storeu_si128((__m128i *)(data + i), v);
+	}
+#elif defined(__ARM_NEON)
+	for (; i + 16 <= size; i += 16) {
+		vst1q_u8(data + i, vrev32q_u8(vld1q_u8(data + i)));
+	}
+#endif
+	for (; i + 4 <= size; i += 4) {
+		boost::endian::store_little_u32(data + i, boost::endian::load_big_u32(data + i));
+	}
+}
+
+static bool isHostEndianness(Endianness endianness) {
+	return (endianness == kLittleEndian) == (boost::endian::order::native == boost::endian::order::little);
+}
+
 /* BufferView */
 
 size_t BufferView::size() const {
@@ -70,6 +123,14 @@ BufferView ReadStream::readByteView(size_t len) {
 	return res;
 }
 
+ReadCursor ReadStream::reserve(size_t len) {
+	return ReadCursor(take(len, "reserve"), endianness);
+}
+
+void ReadStream::throwPastEOF(const char *reader) {
+	throw std::runtime_error(std::string("ReadStream::") + reader + ": Read past end of stream!");
+}
+
 ssize_t ReadStream::readUpToBytes(size_t len, uint8_t *dest) {
 	if (eof())
 		return 0;
@@ -197,48 +258,162 @@ double ReadStream::readAppleFloat80() {
 	return *(double *)(&f64bin);
 }
 
+// A 32-bit varint takes at most 5 bytes
+static const size_t kMaxVarIntSize = 5;
+
+// Decodes a varint of up to 5 bytes, all of which must be readable, and
+// advances p past it. Returns false, leaving p alone, if it's any longer.
+static inline bool decodeVarInt(const uint8_t *&p, uint32_t &val) {
+	// The 7 least significant bits of each byte are appended to the result,
+	// and if the most significant bit is 1, there's another byte after
+	uint32_t b = p[0];
+	val = b & 0x7f;
+	if (b < 0x80) {
+		p += 1;
+		return true;
+	}
+	b = p[1];
+	val = (val << 7) | (b & 0x7f);
+	if (b < 0x80) {
+		p += 2;
+		return true;
+	}
+	b = p[2];
+	val = (val << 7) | (b & 0x7f);
+	if (b < 0x80) {
+		p += 3;
+		return true;
+	}
+	b = p[3];
+	val = (val << 7) | (b & 0x7f);
+	if (b < 0x80) {
+		p += 4;
+		return true;
+	}
+	b = p[4];
+	val = (val << 7) | (b & 0x7f);
+	if (b < 0x80) {
+		p += 5;
+		return true;
+	}
+	return false;
+}
+
 uint32_t ReadStream::readVarInt() {
-	uint32_t val = 0;
+	uint32_t val;
+	if (_pos + kMaxVarIntSize <= _size) {
+		const uint8_t *p = &_data[_pos];
+		if (decodeVarInt(p, val)) {
+			_pos = p - _data;
+			return val;
+		}
+	}
+
+	// Near the end of the stream, or longer than 5 bytes
+	val = 0;
 	uint8_t b;
 	do {
 		b = readUint8();
-		val = (val << 7) | (b & 0x7f); // The 7 least significant bits are appended to the result
-	} while (b >> 7); // If the most significant bit is 1, there's another byte after
+		val = (val << 7) | (b & 0x7f);
+	} while (b >> 7);
 	return val;
 }
 
+void ReadStream::readVarInts(uint32_t *dest, size_t count) {
+	while (count > 0) {
+		// Every varint in a batch fits in the bytes left
+		size_t batch = std::min(count, (_size - std::min(_pos, _size)) / kMaxVarIntSize);
+		if (batch == 0)
+			break;
+
+		const uint8_t *p = &_data[_pos];
+		size_t done = 0;
+		while (done < batch && decodeVarInt(p, dest[done])) {
+			done++;
+		}
+		_pos = p - _data;
+		dest += done;
+		count -= done;
+		if (done < batch) // longer than 5 bytes
+			break;
+	}
+
+	// The rest are near the end of the stream
+	for (size_t i = 0; i < count; i++) {
+		dest[i] = readVarInt();
+	}
+}
+
 std::string ReadStream::readString(size_t len) {
+	return std::string(readStringView(len));
+}
+
+std::string ReadStream::readCString() {
+	return std::string(readCStringView());
+}
+
+std::string ReadStream::readPascalString() {
+	return std::string(readPascalStringView());
+}
+
+std::string_view ReadStream::readStringView(size_t len) {
 	size_t p = _pos;
 	_pos += len;
 	if (pastEOF()) {
 		throw std::runtime_error("ReadStream::readString: Read past end of stream!");
 	}
 
-	char *str = new char[len + 1];
-	memcpy(str, &_data[p], len);
-	str[len] = '\0';
-	std::string res(str);
-	delete[] str;
-	return res;
+	const char *str = (const char *)&_data[p];
+	const char *end = (const char *)memchr(str, '\0', len);
+	return std::string_view(str, end ? end - str : len);
 }
 
-std::string ReadStream::readCString() {
-	std::string res;
-	char ch = readInt8();
-	while (ch) {
-		res += ch;
-		ch = readInt8();
+std::string_view ReadStream::readCStringView() {
+	size_t p = _pos;
+	const void *end = (p < _size) ? memchr(&_data[p], '\0', _size - p) : nullptr;
+	if (!end) {
+		_pos = _size + 1;
+		throw std::runtime_error("ReadStream::readCString: Read past end of stream!");
 	}
-	return res;
+
+	size_t len = (const uint8_t *)end - &_data[p];
+	_pos += len + 1;
+	return std::string_view((const char *)&_data[p], len);
 }
 
-std::string ReadStream::readPascalString() {
+std::string_view ReadStream::readPascalStringView() {
 	uint8_t len = readUint8();
-	return readString(len);
+	return readStringView(len);
+}
+
+void ReadStream::readUint16Array(uint16_t *dest, size_t count) {
+	const uint8_t *src = take(count * 2, "readUint16Array");
+	std::copy_n(src, count * 2, (uint8_t *)dest);
+	if (!isHostEndianness(endianness))
+		swapBytes16((uint8_t *)dest, count * 2);
+}
+
+void ReadStream::readInt16Array(int16_t *dest, size_t count) {
+	readUint16Array((uint16_t *)dest, count);
+}
+
+void ReadStream::readUint32Array(uint32_t *dest, size_t count) {
+	const uint8_t *src = take(count * 4, "readUint32Array");
+	std::copy_n(src, count * 4, (uint8_t *)dest);
+	if (!isHostEndianness(endianness))
+		swapBytes32((uint8_t *)dest, count * 4);
+}
+
+void ReadStream::readInt32Array(int32_t *dest, size_t count) {
+	readUint32Array((uint32_t *)dest, count);
 }
 
 /* WriteStream */
 
+void WriteStream::throwPastEOF(const char *writer) {
+	throw std::runtime_error(std::string("WriteStream::") + writer + ": Write past end of stream!");
+}
+
 size_t WriteStream::writeBytes(const void *dataPtr, size_t dataSize) {
 	size_t p = _pos;
 	_pos += dataSize;
@@ -315,6 +490,17 @@ void WriteStream::writeDouble(double value) {
 		boost::endian::store_big_u64(&_data[p], *(uint64_t *)(&value));
 }
 
+void WriteStream::writeVarInt(uint32_t value) {
+	// Most significant group first, with the high bit set on all but the last byte
+	size_t len = varIntSize(value);
+	for (size_t i = len; i > 0; i--) {
+		uint8_t b = (value >> (7 * (i - 1))) & 0x7f;
+		if (i > 1)
+			b |= 0x80;
+		writeUint8(b);
+	}
+}
+
 void WriteStream::writeString(const std::string &value) {
 	writeBytes(value.c_str(), value.size());
 }
@@ -324,4 +510,12 @@ void WriteStream::writePascalString(const std::string &value) {
 	writeString(value);
 }
 
+size_t WriteStream::varIntSize(uint32_t value) {
+	size_t len = 1;
+	while (value >>= 7) {
+		len++;
+	}
+	return len;
+}
+
 } // namespace Common
@@ -12,8 +12,12 @@
 #include <cstdint>
 #include <istream>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include <boost/endian/conversion.hpp>
+
 namespace Common {
 
 enum Endianness {
@@ -21,6 +25,46 @@ enum Endianness {
 	kLittleEndian = 1
 };
 
+// Reverses the bytes of each 16-bit value in place, 16 bytes at a time where
+// the CPU supports it. A trailing odd byte is left alone.
+void swapBytes16(uint8_t *data, size_t size);
+// The same for 32-bit values. Up to three trailing bytes are left alone.
+void swapBytes32(uint8_t *data, size_t size);
+
+// Loads and stores in an endianness fixed at compile time
+
+template <Endianness E>
+inline uint16_t loadUint16(const uint8_t *p) {
+	if constexpr (E == kLittleEndian)
+		return boost::endian::load_little_u16(p);
+	else
+		return boost::endian::load_big_u16(p);
+}
+
+template <Endianness E>
+inline uint32_t loadUint32(const uint8_t *p) {
+	if constexpr (E == kLittleEndian)
+		return boost::endian::load_little_u32(p);
+	else
+		return boost::endian::load_big_u32(p);
+}
+
+template <Endianness E>
+inline void storeUint16(uint8_t *p, uint16_t value) {
+	if constexpr (E == kLittleEndian)
+		boost::endian::store_little_u16(p, value);
+	else
+		boost::endian::store_big_u16(p, value);
+}
+
+template <Endianness E>
+inline void storeUint32(uint8_t *p, uint32_t value) {
+	if constexpr (E == kLittleEndian)
+		boost::endian::store_little_u32(p, value);
+	else
+		boost::endian::store_big_u32(p, value);
+}
+
 /* BufferView */
 
 class BufferView {
@@ -62,6 +106,70 @@ public:
 	bool pastEOF() const;
 };
 
+/* ReadCursor */
+
+/**
+ * ReadCursor reads a fixed-layout record whose bytes ReadStream::reserve has
+ * already bounds checked, so its fields are read without checking each one.
+ * Reading more than was reserved is undefined.
+ */
+
+class ReadCursor {
+private:
+	const uint8_t *_p;
+	Endianness _endianness;
+
+public:
+	ReadCursor(const uint8_t *p, Endianness e) : _p(p), _endianness(e) {}
+
+	void skip(size_t len) { _p += len; }
+
+	uint8_t readUint8() { return *_p++; }
+	int8_t readInt8() { return (int8_t)readUint8(); }
+
+	uint16_t readUint16() {
+		uint16_t res = _endianness
+			? boost::endian::load_little_u16(_p)
+			: boost::endian::load_big_u16(_p);
+		_p += 2;
+		return res;
+	}
+	int16_t readInt16() { return (int16_t)readUint16(); }
+
+	uint32_t readUint32() {
+		uint32_t res = _endianness
+			? boost::endian::load_little_u32(_p)
+			: boost::endian::load_big_u32(_p);
+		_p += 4;
+		return res;
+	}
+	int32_t readInt32() { return (int32_t)readUint32(); }
+};
+
+/* ReadCursorT */
+
+// A ReadCursor whose endianness is fixed at compile time
+template <Endianness E>
+class ReadCursorT {
+private:
+	const uint8_t *_p;
+
+public:
+	explicit ReadCursorT(const uint8_t *p) : _p(p) {}
+
+	void skip(size_t len) { _p += len; }
+
+	uint8_t readUint8() { return *_p++; }
+	int8_t readInt8() { return (int8_t)readUint8(); }
+	uint16_t readUint16() { uint16_t res = loadUint16<E>(_p); _p += 2; return res; }
+	int16_t readInt16() { return (int16_t)readUint16(); }
+	uint32_t readUint32() { uint32_t res = loadUint32<E>(_p); _p += 4; return res; }
+	int32_t readInt32() { return (int32_t)readUint32(); }
+};
+
+typedef ReadCursorT<kBigEndian> BigEndianReadCursor;
+typedef ReadCursorT<kLittleEndian> LittleEndianReadCursor;
+
 /* ReadStream */
 
 class ReadStream : public Stream {
@@ -73,6 +181,9 @@ public:
 		: Stream(view, e, p) {}
 
 	BufferView readByteView(size_t len);
+	// Throws unless len more bytes can be read, then skips them and returns
+	// a cursor over them
+	ReadCursor reserve(size_t len);
 	ssize_t readUpToBytes(size_t len, uint8_t *dest);
 	ssize_t readZlibBytes(size_t len, uint8_t *dest, size_t destLen);
 	uint8_t readUint8();
@@ -84,11 +195,80 @@ public:
 	double readDouble();
 	double readAppleFloat80();
 	uint32_t readVarInt();
+	// Reads count varints into dest, checking the bounds once per batch
+	// rather than once per byte
+	void readVarInts(uint32_t *dest, size_t count);
+	// Read count values into dest, checking the bounds once and swapping
+	// the whole array at once if the stream isn't in the host's byte order
+	void readUint16Array(uint16_t *dest, size_t count);
+	void readInt16Array(int16_t *dest, size_t count);
+	void readUint32Array(uint32_t *dest, size_t count);
+	void readInt32Array(int32_t *dest, size_t count);
 	std::string readString(size_t len);
 	std::string readCString();
 	std::string readPascalString();
+
+	// These point into the stream's buffer instead of copying. Like the
+	// readers above, a string ends at the first NUL within its length.
+	std::string_view readStringView(size_t len);
+	std::string_view readCStringView();
+	std::string_view readPascalStringView();
+
+protected:
+	// Skips len bytes and returns where they start, or throws naming the
+	// reader if they run past the end
+	const uint8_t *take(size_t len, const char *reader) {
+		size_t p = _pos;
+		_pos += len;
+		if (pastEOF())
+			throwPastEOF(reader);
+		return &_data[p];
+	}
+	[[noreturn]] static void throwPastEOF(const char *reader);
+};
+
+/* ReadStreamT */
+
+/**
+ * ReadStreamT is a ReadStream whose endianness is fixed at compile time, for
+ * formats that are always one endianness whatever the file's (Lingo
+ * bytecode, for instance). Its endianness field is set to E, and shouldn't
+ * be changed.
+ *
+ * Its integer readers and reserve() are inline and always read E without
+ * looking at the field. They hide the ReadStream ones rather than override
+ * them, so calls through a plain ReadStream, and the readers it doesn't
+ * redefine (readDouble, readVarInt, the array readers and so on), go by the
+ * field as usual. Anything taking a plain ReadStream can still be given one.
+ */
+
+template <Endianness E>
+class ReadStreamT : public ReadStream {
+public:
+	ReadStreamT(uint8_t *d, size_t s, size_t p = 0)
+		: ReadStream(d, s, E, p) {}
+
+	explicit ReadStreamT(const BufferView &view, size_t p = 0)
+		: ReadStream(view, E, p) {}
+
+	// Starts where the other stream is. The other stream doesn't move, so a
+	// read() given a plain stream that reads through one of these seeks that
+	// stream to pos() when done, leaving it where reading it directly would.
+	explicit ReadStreamT(const ReadStream &stream)
+		: ReadStream(stream.data(), stream.size(), E, stream.pos()) {}
+
+	ReadCursorT<E> reserve(size_t len) { return ReadCursorT<E>(take(len, "reserve")); }
+	uint8_t readUint8() { return *take(1, "readUint8"); }
+	int8_t readInt8() { return (int8_t)readUint8(); }
+	uint16_t readUint16() { return loadUint16<E>(take(2, "readUint16")); }
+	int16_t readInt16() { return (int16_t)readUint16(); }
+	uint32_t readUint32() { return loadUint32<E>(take(4, "readUint32")); }
+	int32_t readInt32() { return (int32_t)readUint32(); }
 };
 
+typedef ReadStreamT<kBigEndian> BigEndianReadStream;
+typedef ReadStreamT<kLittleEndian> LittleEndianReadStream;
+
 /* WriteStream */
 
 class WriteStream : public Stream {
@@ -108,10 +288,51 @@ public:
 	void writeUint32(uint32_t value);
 	void writeInt32(int32_t value);
 	void writeDouble(double value);
+	void writeVarInt(uint32_t value);
 	void writeString(const std::string &value);
 	void writePascalString(const std::string &value);
+
+	static size_t varIntSize(uint32_t value);
+
+protected:
+	uint8_t *take(size_t len, const char *writer) {
+		size_t p = _pos;
+		_pos += len;
+		if (pastEOF())
+			throwPastEOF(writer);
+		return &_data[p];
+	}
+	[[noreturn]] static void throwPastEOF(const char *writer);
+};
+
+/* WriteStreamT */
+
+// The WriteStream counterpart of ReadStreamT
+template <Endianness E>
+class WriteStreamT : public WriteStream {
+public:
+	WriteStreamT(uint8_t *d, size_t s, size_t p = 0)
+		: WriteStream(d, s, E, p) {}
+
+	explicit WriteStreamT(const BufferView &view, size_t p = 0)
+		: WriteStream(view, E, p) {}
+
+	// Starts where the other stream is. As with ReadStreamT, the other stream
+	// doesn't move, so a write() using one seeks that stream to pos() when done.
+	explicit WriteStreamT(const WriteStream &stream)
+		: WriteStream(stream.data(), stream.size(), E, stream.pos()) {}
+
+	void writeUint8(uint8_t value) { *take(1, "writeUint8") = value; }
+	void writeInt8(int8_t value) { writeUint8((uint8_t)value); }
+	void writeUint16(uint16_t value) { storeUint16<E>(take(2, "writeUint16"), value); }
+	void writeInt16(int16_t value) { writeUint16((uint16_t)value); }
+	void writeUint32(uint32_t value) { storeUint32<E>(take(4, "writeUint32"), value); }
+	void writeInt32(int32_t value) { writeUint32((uint32_t)value); }
 };
 
+typedef WriteStreamT<kBigEndian> BigEndianWriteStream;
+typedef WriteStreamT<kLittleEndian> LittleEndianWriteStream;
+
 } // namespace Common
 
 #endif // COMMON_STREAM_H
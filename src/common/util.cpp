@@ -15,12 +15,16 @@
 namespace Common {
 
 std::string fourCCToString(uint32_t fourcc) {
-	char str[4];
-	str[0] = (char)(fourcc >> 24);
-	str[1] = (char)(fourcc >> 16);
-	str[2] = (char)(fourcc >> 8);
-	str[3] = (char)fourcc;
-	return escapeString(str, sizeof(str));
+	return escapeString(rawFourCC(fourcc));
+}
+
+std::string rawFourCC(uint32_t fourcc) {
+	std::string res(4, '\0');
+	res[0] = (char)(fourcc >> 24);
+	res[1] = (char)(fourcc >> 16);
+	res[2] = (char)(fourcc >> 8);
+	res[3] = (char)fourcc;
+	return res;
 }
 
 std::string floatToString(double f) {
@@ -97,4 +101,11 @@ int compareIgnoreCase(const std::string &a, const std::string &b) {
 	return stricmp(a.c_str(), b.c_str());
 }
 
+std::string toLowercase(std::string str) {
+	for (char &ch : str) {
+		ch = tolower((unsigned char)ch);
+	}
+	return str;
+}
+
 } // namespace Common
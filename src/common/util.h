@@ -18,12 +18,14 @@
 namespace Common {
 
 std::string fourCCToString(uint32_t fourcc);
+std::string rawFourCC(uint32_t fourcc); // the four bytes, unescaped
 std::string floatToString(double f);
 std::string byteToString(uint8_t byte);
 std::string escapeString(const char *str, size_t size);
 std::string escapeString(std::string str);
 int stricmp(const char *a, const char *b);
 int compareIgnoreCase(const std::string &a, const std::string &b);
+std::string toLowercase(std::string str);
 
 } // namespace Common
 
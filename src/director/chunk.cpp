@@ -29,12 +29,24 @@ void Chunk::writeJSON(Common::JSONWriter &json) const {
 
 /* CastChunk */
 
-void CastChunk::read(Common::ReadStream &stream) {
-	stream.endianness = Common::kBigEndian;
-	while (!stream.eof()) {
-		auto id = stream.readInt32();
-		memberIDs.push_back(id);
+void CastChunk::read(Common::ReadStream &chunkStream) {
+	Common::BigEndianReadStream stream(chunkStream);
+	// IDs run to the end. A truncated last one reads past it and throws.
+	memberIDs.resize((stream.size() - stream.pos() + 3) / 4);
+	stream.readInt32Array(memberIDs.data(), memberIDs.size());
+	chunkStream.seek(stream.pos());
+}
+
+size_t CastChunk::size() {
+	return 4 * memberIDs.size();
+}
+
+void CastChunk::write(Common::WriteStream &chunkStream) {
+	Common::BigEndianWriteStream stream(chunkStream);
+	for (auto id : memberIDs) {
+		stream.writeInt32(id);
 	}
+	chunkStream.seek(stream.pos());
 }
 
 void CastChunk::writeJSON(Common::JSONWriter &json) const {
@@ -50,6 +62,16 @@ void CastChunk::writeJSON(Common::JSONWriter &json) const {
 
 void CastChunk::populate(const std::string &castName, int32_t id, uint16_t minMember) {
 	name = castName;
+	readContext(id);
+
+	for (size_t i = 0; i < memberIDs.size(); i++) {
+		readMember(i + minMember, minMember);
+	}
+}
+
+void CastChunk::readContext(int32_t id) {
+	if (lctx)
+		return;
 
 	for (const auto &entry : dir->keyTable->entries) {
 		if (entry.castID == id
@@ -59,24 +81,33 @@ void CastChunk::populate(const std::string &castName, int32_t id, uint16_t minMe
 			break;
 		}
 	}
+}
 
-	for (size_t i = 0; i < memberIDs.size(); i++) {
-		int32_t sectionID = memberIDs[i];
-		if (sectionID > 0) {
-			CastMemberChunk *member = static_cast<CastMemberChunk *>(dir->getChunk(FOURCC('C', 'A', 'S', 't'), sectionID));
-			member->id = i + minMember;
-			Common::debug(boost::format("Member %u: name: \"%s\" chunk: %d")
-							% member->id % member->getName() % sectionID);
-			if (!member->info) {
-				Common::debug(boost::format("Member %u: No info!") % member->id);
-			}
-			if (lctx && (lctx->scripts.find(member->getScriptID()) != lctx->scripts.end())) {
-				member->script = static_cast<ScriptChunk *>(lctx->scripts[member->getScriptID()]);
-				member->script->member = member;
-			}
-			members[member->id] = member;
+// Reads one member and links it to its script. Call readContext first.
+CastMemberChunk *CastChunk::readMember(uint16_t memberID, uint16_t minMember) {
+	if (memberID < minMember || (size_t)(memberID - minMember) >= memberIDs.size())
+		return nullptr;
+
+	int32_t sectionID = memberIDs[memberID - minMember];
+	if (sectionID <= 0)
+		return nullptr;
+
+	CastMemberChunk *member = static_cast<CastMemberChunk *>(dir->getChunk(FOURCC('C', 'A', 'S', 't'), sectionID));
+	member->id = memberID;
+	Common::debug(boost::format("Member %u: name: \"%s\" chunk: %d")
+					% member->id % member->getName() % sectionID);
+	if (!member->info) {
+		Common::debug(boost::format("Member %u: No info!") % member->id);
+	}
+	if (lctx) {
+		LingoDec::Script *script = lctx->loadScript(member->getScriptID());
+		if (script) {
+			member->script = static_cast<ScriptChunk *>(script);
+			member->script->member = member;
 		}
 	}
+	members[member->id] = member;
+	return member;
 }
 
 /* CastListChunk */
@@ -109,6 +140,75 @@ void CastListChunk::readHeader(Common::ReadStream &stream) {
 	unk1 = stream.readUint16();
 }
 
+size_t CastListChunk::headerSize() {
+	size_t len = 0;
+	len += 4; // dataOffset
+	len += 2; // unk0
+	len += 2; // castCount
+	len += 2; // itemsPerCast
+	len += 2; // unk1
+	return len;
+}
+
+void CastListChunk::writeHeader(Common::WriteStream &stream) {
+	stream.writeUint32(headerSize());
+	stream.writeUint16(unk0);
+	stream.writeUint16(castCount);
+	stream.writeUint16(itemsPerCast);
+	stream.writeUint16(unk1);
+}
+
+size_t CastListChunk::itemSize(uint16_t index) {
+	if (index == 0 || itemsPerCast == 0)
+		return ListChunk::itemSize(index);
+
+	const CastListEntry &entry = entries[(index - 1) / itemsPerCast];
+	switch ((index - 1) % itemsPerCast + 1) {
+	case 1:
+		return (entry.name.size() > 0) ? 1 + entry.name.size() : 0;
+	case 2:
+		return (entry.filePath.size() > 0) ? 1 + entry.filePath.size() : 0;
+	case 3:
+		return 2; // preloadSettings
+	case 4:
+		return 8; // minMember, maxMember, id
+	default:
+		return ListChunk::itemSize(index);
+	}
+}
+
+void CastListChunk::writeItem(Common::WriteStream &stream, uint16_t index) {
+	if (index == 0 || itemsPerCast == 0) {
+		ListChunk::writeItem(stream, index);
+		return;
+	}
+
+	const CastListEntry &entry = entries[(index - 1) / itemsPerCast];
+	switch ((index - 1) % itemsPerCast + 1) {
+	case 1:
+		if (entry.name.size() > 0) {
+			stream.writePascalString(entry.name);
+		}
+		break;
+	case 2:
+		if (entry.filePath.size() > 0) {
+			stream.writePascalString(entry.filePath);
+		}
+		break;
+	case 3:
+		stream.writeUint16(entry.preloadSettings);
+		break;
+	case 4:
+		stream.writeUint16(entry.minMember);
+		stream.writeUint16(entry.maxMember);
+		stream.writeInt32(entry.id);
+		break;
+	default:
+		ListChunk::writeItem(stream, index);
+		break;
+	}
+}
+
 void CastListChunk::writeJSON(Common::JSONWriter &json) const {
 	json.startObject();
 		JSON_WRITE_FIELD(dataOffset);
@@ -127,8 +227,8 @@ void CastListChunk::writeJSON(Common::JSONWriter &json) const {
 
 /* CastMemberChunk */
 
-void CastMemberChunk::read(Common::ReadStream &stream) {
-	stream.endianness = Common::kBigEndian;
+void CastMemberChunk::read(Common::ReadStream &chunkStream) {
+	Common::BigEndianReadStream stream(chunkStream);
 
 	if (dir->version >= 500) {
 		type = static_cast<MemberType>(stream.readUint32());
@@ -137,7 +237,7 @@ void CastMemberChunk::read(Common::ReadStream &stream) {
 
 		// info
 		if (infoLen) {
-			Common::ReadStream infoStream(stream.readByteView(infoLen), stream.endianness);
+			Common::ReadStream infoStream(stream.readByteView(infoLen), Common::kBigEndian);
 			info = std::make_shared<CastInfoChunk>(dir);
 			info->read(infoStream);
 		}
@@ -165,12 +265,13 @@ void CastMemberChunk::read(Common::ReadStream &stream) {
 		specificData = stream.readByteView(specificDataLeft);
 
 		// info
-		Common::ReadStream infoStream(stream.readByteView(infoLen), stream.endianness);
+		Common::ReadStream infoStream(stream.readByteView(infoLen), Common::kBigEndian);
 		if (infoLen) {
 			info = std::make_shared<CastInfoChunk>(dir);
 			info->read(infoStream);
 		}
 	}
+	chunkStream.seek(stream.pos());
 
 	switch (type) {
 	case kScriptMember:
@@ -180,7 +281,7 @@ void CastMemberChunk::read(Common::ReadStream &stream) {
 		member = std::make_unique<CastMember>(dir, type);
 		break;
 	}
-	Common::ReadStream specificStream(specificData, stream.endianness);
+	Common::ReadStream specificStream(specificData, Common::kBigEndian);
 	member->read(specificStream);
 }
 
@@ -209,8 +310,8 @@ size_t CastMemberChunk::size() {
 	return len;
 }
 
-void CastMemberChunk::write(Common::WriteStream &stream) {
-	stream.endianness = Common::kBigEndian;
+void CastMemberChunk::write(Common::WriteStream &chunkStream) {
+	Common::BigEndianWriteStream stream(chunkStream);
 
 	if (dir->version >= 500) {
 		stream.writeUint32(type);
@@ -232,6 +333,7 @@ void CastMemberChunk::write(Common::WriteStream &stream) {
 			info->write(stream);
 		}
 	}
+	chunkStream.seek(stream.pos());
 }
 
 uint32_t CastMemberChunk::getScriptID() const {
@@ -385,56 +487,58 @@ void CastInfoChunk::writeJSON(Common::JSONWriter &json) const {
 
 /* ConfigChunk */
 
-void ConfigChunk::read(Common::ReadStream &stream) {
-	stream.endianness = Common::kBigEndian;
+void ConfigChunk::read(Common::ReadStream &chunkStream) {
+	Common::BigEndianReadStream stream(chunkStream);
 
 	stream.seek(36);
 	directorVersion = stream.readInt16();
 	unsigned int ver = humanVersion(directorVersion);
 
 	stream.seek(0);
-	/*  0 */ len = stream.readInt16();
-	/*  2 */ fileVersion = stream.readInt16();
-	/*  4 */ movieTop = stream.readInt16();
-	/*  6 */ movieLeft = stream.readInt16();
-	/*  8 */ movieBottom = stream.readInt16();
-	/* 10 */ movieRight = stream.readInt16();
-	/* 12 */ minMember = stream.readInt16();
-	/* 14 */ maxMember = stream.readInt16();
-	/* 16 */ field9 = stream.readInt8();
-	/* 17 */ field10 = stream.readInt8();
+	Common::BigEndianReadCursor fields = stream.reserve(68);
+	/*  0 */ len = fields.readInt16();
+	/*  2 */ fileVersion = fields.readInt16();
+	/*  4 */ movieTop = fields.readInt16();
+	/*  6 */ movieLeft = fields.readInt16();
+	/*  8 */ movieBottom = fields.readInt16();
+	/* 10 */ movieRight = fields.readInt16();
+	/* 12 */ minMember = fields.readInt16();
+	/* 14 */ maxMember = fields.readInt16();
+	/* 16 */ field9 = fields.readInt8();
+	/* 17 */ field10 = fields.readInt8();
 	if (ver < 700) {
-		/* 18 */ preD7field11 = stream.readInt16();
+		/* 18 */ preD7field11 = fields.readInt16();
 	} else {
-		/* 18 */ D7stageColorG = stream.readUint8();
-		/* 19 */ D7stageColorB = stream.readUint8();
+		/* 18 */ D7stageColorG = fields.readUint8();
+		/* 19 */ D7stageColorB = fields.readUint8();
 	}
-	/* 20 */ commentFont = stream.readInt16();
-	/* 22 */ commentSize = stream.readInt16();
-	/* 24 */ commentStyle = stream.readUint16();
+	/* 20 */ commentFont = fields.readInt16();
+	/* 22 */ commentSize = fields.readInt16();
+	/* 24 */ commentStyle = fields.readUint16();
 	if (ver < 700) {
-		/* 26 */ preD7stageColor = stream.readInt16();
+		/* 26 */ preD7stageColor = fields.readInt16();
 	} else {
-		/* 26 */ D7stageColorIsRGB = stream.readUint8();
-		/* 27 */ D7stageColorR = stream.readUint8();
+		/* 26 */ D7stageColorIsRGB = fields.readUint8();
+		/* 27 */ D7stageColorR = fields.readUint8();
 	}
-	/* 28 */ bitDepth = stream.readInt16();
-	/* 30 */ field17 = stream.readUint8();
-	/* 31 */ field18 = stream.readUint8();
-	/* 32 */ field19 = stream.readInt32();
-	/* 36 */ /* directorVersion = */ stream.readInt16();
-	/* 38 */ field21 = stream.readInt16();
-	/* 40 */ field22 = stream.readInt32();
-	/* 44 */ field23 = stream.readInt32();
-	/* 48 */ field24 = stream.readInt32();
-	/* 52 */ field25 = stream.readInt8();
-	/* 53 */ field26 = stream.readUint8();
-	/* 54 */ frameRate = stream.readInt16();
-	/* 56 */ platform = stream.readInt16();
-	/* 58 */ protection = stream.readInt16();
-	/* 60 */ field29 = stream.readInt32();
-	/* 64 */ checksum = stream.readUint32();
+	/* 28 */ bitDepth = fields.readInt16();
+	/* 30 */ field17 = fields.readUint8();
+	/* 31 */ field18 = fields.readUint8();
+	/* 32 */ field19 = fields.readInt32();
+	/* 36 */ /* directorVersion = */ fields.readInt16();
+	/* 38 */ field21 = fields.readInt16();
+	/* 40 */ field22 = fields.readInt32();
+	/* 44 */ field23 = fields.readInt32();
+	/* 48 */ field24 = fields.readInt32();
+	/* 52 */ field25 = fields.readInt8();
+	/* 53 */ field26 = fields.readUint8();
+	/* 54 */ frameRate = fields.readInt16();
+	/* 56 */ platform = fields.readInt16();
+	/* 58 */ protection = fields.readInt16();
+	/* 60 */ field29 = fields.readInt32();
+	/* 64 */ checksum = fields.readUint32();
 	/* 68 */ remnants = stream.readByteView(len - stream.pos());
+	chunkStream.seek(stream.pos());
 
 	uint32_t computedChecksum = computeChecksum();
 	if (checksum != computedChecksum) {
@@ -446,8 +550,8 @@ size_t ConfigChunk::size() {
 	return len;
 }
 
-void ConfigChunk::write(Common::WriteStream &stream) {
-	stream.endianness = Common::kBigEndian;
+void ConfigChunk::write(Common::WriteStream &chunkStream) {
+	Common::BigEndianWriteStream stream(chunkStream);
 
 	unsigned int ver = humanVersion(directorVersion);
 
@@ -495,6 +599,7 @@ void ConfigChunk::write(Common::WriteStream &stream) {
 	/* 60 */ stream.writeInt32(field29);
 	/* 64 */ stream.writeUint32(checksum);
 	/* 68 */ stream.writeBytes(remnants);
+	chunkStream.seek(stream.pos());
 }
 
 uint32_t ConfigChunk::computeChecksum() {
@@ -693,10 +798,11 @@ void InitialMapChunk::writeJSON(Common::JSONWriter &json) const {
 /* KeyTableChunk */
 
 void KeyTableChunk::read(Common::ReadStream &stream) {
-	entrySize = stream.readUint16();
-	entrySize2 = stream.readUint16();
-	entryCount = stream.readUint32();
-	usedCount = stream.readUint32();
+	Common::ReadCursor header = stream.reserve(12);
+	entrySize = header.readUint16();
+	entrySize2 = header.readUint16();
+	entryCount = header.readUint32();
+	usedCount = header.readUint32();
 
 	entries.resize(entryCount);
 	for (auto &entry : entries) {
@@ -704,6 +810,26 @@ void KeyTableChunk::read(Common::ReadStream &stream) {
 	}
 }
 
+size_t KeyTableChunk::size() {
+	size_t len = 0;
+	len += 2; // entrySize
+	len += 2; // entrySize2
+	len += 4; // entryCount
+	len += 4; // usedCount
+	len += entries.size() * entrySize; // entries
+	return len;
+}
+
+void KeyTableChunk::write(Common::WriteStream &stream) {
+	stream.writeUint16(entrySize);
+	stream.writeUint16(entrySize2);
+	stream.writeUint32(entries.size());
+	stream.writeUint32(usedCount);
+	for (auto &entry : entries) {
+		entry.write(stream);
+	}
+}
+
 void KeyTableChunk::writeJSON(Common::JSONWriter &json) const {
 	json.startObject();
 		JSON_WRITE_FIELD(entrySize);
@@ -737,9 +863,7 @@ void ListChunk::readOffsetTable(Common::ReadStream &stream) {
 	stream.seek(dataOffset);
 	offsetTableLen = stream.readUint16();
 	offsetTable.resize(offsetTableLen);
-	for (uint16_t i = 0; i < offsetTableLen; i++) {
-		offsetTable[i] = stream.readUint32();
-	}
+	stream.readUint32Array(offsetTable.data(), offsetTableLen);
 }
 
 void ListChunk::readItems(Common::ReadStream &stream) {
@@ -870,13 +994,14 @@ void ListChunk::writeItem(Common::WriteStream &stream, uint16_t index) {
 /* MemoryMapChunk */
 
 void MemoryMapChunk::read(Common::ReadStream &stream) {
-	headerLength = stream.readInt16();
-	entryLength = stream.readInt16();
-	chunkCountMax = stream.readInt32();
-	chunkCountUsed = stream.readInt32();
-	junkHead = stream.readInt32();
-	junkHead2 = stream.readInt32();
-	freeHead = stream.readInt32();
+	Common::ReadCursor header = stream.reserve(24);
+	headerLength = header.readInt16();
+	entryLength = header.readInt16();
+	chunkCountMax = header.readInt32();
+	chunkCountUsed = header.readInt32();
+	junkHead = header.readInt32();
+	junkHead2 = header.readInt32();
+	freeHead = header.readInt32();
 	mapArray.resize(chunkCountUsed);
 	for (auto &entry : mapArray) {
 		entry.read(stream);
@@ -1033,7 +1158,9 @@ void ScriptChunk::writeDatumJSON(const LingoDec::Datum &datum, Common::JSONWrite
 
 ScriptContextChunk::ScriptContextChunk(DirectorFile *m) :
 		Chunk(m, kScriptContextChunk),
-		LingoDec::ScriptContext(m->version, m) {}
+		LingoDec::ScriptContext(m->version, m) {
+	lazy = m->lazyCasts;
+}
 
 void ScriptContextChunk::read(Common::ReadStream &stream) {
 	LingoDec::ScriptContext::read(stream);
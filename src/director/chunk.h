@@ -113,7 +113,11 @@ struct CastChunk : Chunk {
 	CastChunk(DirectorFile *m) : Chunk(m, kCastChunk), lctx(nullptr) {}
 	virtual ~CastChunk() = default;
 	virtual void read(Common::ReadStream &stream);
+	virtual size_t size();
+	virtual void write(Common::WriteStream &stream);
 	void populate(const std::string &castName, int32_t id, uint16_t minMember);
+	void readContext(int32_t id);
+	CastMemberChunk *readMember(uint16_t memberID, uint16_t minMember);
 	virtual void writeJSON(Common::JSONWriter &json) const;
 };
 
@@ -128,6 +132,10 @@ struct CastListChunk : ListChunk {
 	virtual ~CastListChunk() = default;
 	virtual void read(Common::ReadStream &stream);
 	virtual void readHeader(Common::ReadStream &stream);
+	virtual size_t headerSize();
+	virtual void writeHeader(Common::WriteStream &stream);
+	virtual size_t itemSize(uint16_t index);
+	virtual void writeItem(Common::WriteStream &stream, uint16_t index);
 	virtual void writeJSON(Common::JSONWriter &json) const;
 };
 
@@ -287,6 +295,8 @@ struct KeyTableChunk : Chunk {
 	KeyTableChunk(DirectorFile *m) : Chunk(m, kKeyTableChunk) {}
 	virtual ~KeyTableChunk() = default;
 	virtual void read(Common::ReadStream &stream);
+	virtual size_t size();
+	virtual void write(Common::WriteStream &stream);
 	virtual void writeJSON(Common::JSONWriter &json) const;
 };
 
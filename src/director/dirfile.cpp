@@ -4,9 +4,13 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include <algorithm>
 #include <filesystem>
+#include <functional>
+#include <set>
 #include <sstream>
 #include <stdexcept>
+#include <zlib.h>
 
 namespace fs = std::filesystem;
 
@@ -22,22 +26,83 @@ namespace fs = std::filesystem;
 #include "director/subchunk.h"
 #include "director/util.h"
 #include "io/fileio.h"
+#include "io/scriptcache.h"
+#include "io/stats.h"
+#include "io/threadpool.h"
+#include "lingodec/ast.h"
+#include "lingodec/context.h"
+#include "lingodec/handler.h"
+#include "lingodec/names.h"
 
 namespace Director {
 
 static const size_t kRIFXHeaderSize = 12;
 static const size_t kChunkHeaderSize = 8;
 
+// Rough footprint of an AST node, including its shared_ptr control block
+static const size_t kASTNodeSizeEstimate = 96;
+
+/* ILSInflater */
+
+// Inflates the initial load segment a piece at a time
+struct ILSInflater {
+	z_stream zs;
+	uint8_t *out;
+	size_t outLen;
+	size_t filled;
+	bool ended;
+	bool ok;
+
+	ILSInflater(const Common::BufferView &in, uint8_t *out, size_t outLen) : out(out), outLen(outLen), filled(0), ended(false) {
+		zs = z_stream();
+		zs.next_in = in.data();
+		zs.avail_in = in.size();
+		ok = (inflateInit(&zs) == Z_OK);
+	}
+
+	~ILSInflater() {
+		if (ok)
+			inflateEnd(&zs);
+	}
+
+	// Inflates until at least len bytes of output are available or the
+	// stream ends. Returns false on a zlib error.
+	bool fill(size_t len) {
+		static const size_t kStep = 64 * 1024;
+		while (ok && !ended && filled < len) {
+			zs.next_out = out + filled;
+			zs.avail_out = std::min(outLen - filled, std::max(len - filled, kStep));
+			int ret = inflate(&zs, Z_NO_FLUSH);
+			filled = zs.next_out - out;
+			if (ret == Z_STREAM_END) {
+				ended = true;
+			} else if (ret != Z_OK) {
+				Common::warning(boost::format("zlib decompression error %d!") % ret);
+				ok = false;
+			}
+		}
+		return ok;
+	}
+};
+
 /* DirectorFile */
 
 DirectorFile::DirectorFile() :
 	_ilsBodyOffset(0),
+	_ilsParsed(0),
 	stream(nullptr),
 	keyTable(nullptr),
 	config(nullptr),
 	version(0),
 	codec(0),
-	afterburned(false) {}
+	afterburned(false),
+	memoryBudget(0),
+	lazyCasts(false),
+	soundPool(nullptr),
+	scriptCache(nullptr),
+	scriptCacheHits(0),
+	scriptCacheMisses(0),
+	scriptParseTime(0.0) {}
 
 DirectorFile::~DirectorFile() = default;
 
@@ -72,6 +137,8 @@ bool DirectorFile::read(Common::ReadStream *s) {
 		return false;
 	if (!readConfig())
 		return false;
+	if (lazyCasts)
+		return true;
 	if (!readCasts())
 		return false;
 
@@ -94,8 +161,10 @@ void DirectorFile::readMemoryMap() {
 		if (mapEntry.fourCC == FOURCC('f', 'r', 'e', 'e') || mapEntry.fourCC == FOURCC('j', 'u', 'n', 'k'))
 			continue;
 
-		Common::debug(boost::format("Found RIFX resource index %d: '%s', %u bytes @ pos 0x%08x (%d)")
-						% i % Common::fourCCToString(mapEntry.fourCC) % mapEntry.len % mapEntry.offset % mapEntry.offset);
+		if (Common::g_verbose) { // skip formatting every entry otherwise
+			Common::debug(boost::format("Found RIFX resource index %d: '%s', %u bytes @ pos 0x%08x (%d)")
+							% i % Common::fourCCToString(mapEntry.fourCC) % mapEntry.len % mapEntry.offset % mapEntry.offset);
+		}
 
 		ChunkInfo info;
 		info.id = i;
@@ -162,9 +231,9 @@ bool DirectorFile::readAfterburnerMap() {
 	for (auto &compressionID : compressionIDs) {
 		compressionID.read(fcdrStream);
 	}
-	std::vector<std::string> compressionDescs(compressionTypeCount);
+	std::vector<std::string_view> compressionDescs(compressionTypeCount);
 	for (auto &compressionDesc : compressionDescs) {
-		compressionDesc = fcdrStream.readCString();
+		compressionDesc = fcdrStream.readCStringView();
 	}
 	if (fcdrStream.pos() != (unsigned)fcdrUncompLength) {
 		Common::warning(boost::format("readAfterburnerMap(): Fcdr has uncompressed length %zu but read %zu bytes")
@@ -208,15 +277,19 @@ bool DirectorFile::readAfterburnerMap() {
 					% abmpUnk1 % abmpUnk2 % resCount);
 
 	for (uint32_t i = 0; i < resCount; i++) {
-		int32_t resId = abmpStream.readVarInt();
-		int32_t offset = abmpStream.readVarInt();
-		uint32_t compSize = abmpStream.readVarInt();
-		uint32_t uncompSize = abmpStream.readVarInt();
-		uint32_t compressionType = abmpStream.readVarInt();
+		uint32_t fields[5];
+		abmpStream.readVarInts(fields, 5);
+		int32_t resId = fields[0];
+		int32_t offset = fields[1];
+		uint32_t compSize = fields[2];
+		uint32_t uncompSize = fields[3];
+		uint32_t compressionType = fields[4];
 		uint32_t tag = abmpStream.readUint32();
 
-		Common::debug(boost::format("Found RIFX resource index %d: '%s', %u bytes (%u uncompressed) @ pos 0x%08x (%d), compressionType: %u")
-						% resId % Common::fourCCToString(tag) % compSize % uncompSize % offset % offset % compressionType);
+		if (Common::g_verbose) {
+			Common::debug(boost::format("Found RIFX resource index %d: '%s', %u bytes (%u uncompressed) @ pos 0x%08x (%d), compressionType: %u")
+							% resId % Common::fourCCToString(tag) % compSize % uncompSize % offset % offset % compressionType);
+		}
 
 		ChunkInfo info;
 		info.id = resId;
@@ -245,27 +318,58 @@ bool DirectorFile::readAfterburnerMap() {
 	Common::debug(boost::format("ILS: length: %u unk1: %u") % ilsInfo.len % ilsUnk1);
 	_ilsBodyOffset = stream->pos();
 	_ilsBuf.resize(ilsInfo.uncompressedLen);
-	ssize_t ilsActualUncompLength = stream->readZlibBytes(ilsInfo.len, _ilsBuf.data(), _ilsBuf.size());
-	if (ilsActualUncompLength == -1) {
+	memory.allocate(Common::kMemoryILS, _ilsBuf.size());
+	_ilsInflater = std::make_unique<ILSInflater>(stream->readByteView(ilsInfo.len), _ilsBuf.data(), _ilsBuf.size());
+	_ilsParsed = 0;
+	if (!_ilsInflater->ok) {
 		Common::warning("ILS: Could not decompress");
 		return false;
 	}
-	if ((unsigned)ilsActualUncompLength != ilsInfo.uncompressedLen) {
-		Common::warning(boost::format("ILS: Expected uncompressed length %u but got length %zu")
-						% ilsInfo.uncompressedLen % (unsigned)ilsActualUncompLength);
-	}
-	Common::ReadStream ilsStream(_ilsBuf.data(), ilsInfo.uncompressedLen, endianness);
 
+	// A lazily read file inflates the ILS as its chunks are requested
+	if (!lazyCasts && !readILS(-1))
+		return false;
+
+	return true;
+}
+
+// Inflates and indexes the initial load segment until the chunk with the
+// given ID has been found, or to the end if it isn't there
+bool DirectorFile::readILS(int32_t untilID) {
+	if (!_ilsInflater)
+		return true;
+
+	Common::ReadStream ilsStream(_ilsBuf.data(), _ilsBuf.size(), endianness);
+	ilsStream.seek(_ilsParsed);
 	while (!ilsStream.eof()) {
+		if (!_ilsInflater->fill(std::min(ilsStream.pos() + 5, _ilsBuf.size()))) { // varint is at most 5 bytes
+			Common::warning("ILS: Could not decompress");
+			return false;
+		}
 		int32_t resId = ilsStream.readVarInt();
 		ChunkInfo &info = chunkInfo[resId];
 
-		Common::debug(boost::format("Loading ILS resource %d: '%s', %u bytes")
-						% resId % Common::fourCCToString(info.fourCC) % info.len);
+		if (Common::g_verbose) {
+			Common::debug(boost::format("Loading ILS resource %d: '%s', %u bytes")
+							% resId % Common::fourCCToString(info.fourCC) % info.len);
+		}
 
+		if (!_ilsInflater->fill(std::min(ilsStream.pos() + info.len, _ilsBuf.size()))) {
+			Common::warning("ILS: Could not decompress");
+			return false;
+		}
 		_cachedChunkViews[resId] = ilsStream.readByteView(info.len);
+		_ilsParsed = ilsStream.pos();
+
+		if (resId == untilID)
+			return true;
 	}
 
+	if (_ilsInflater->filled != _ilsBuf.size()) {
+		Common::warning(boost::format("ILS: Expected uncompressed length %u but got length %zu")
+						% _ilsBuf.size() % _ilsInflater->filled);
+	}
+	_ilsInflater.reset();
 	return true;
 }
 
@@ -274,14 +378,16 @@ bool DirectorFile::readKeyTable() {
 	if (info) {
 		keyTable = static_cast<KeyTableChunk *>(getChunk(info->fourCC, info->id));
 
-		for (size_t i = 0; i < keyTable->usedCount; i++) {
-			const KeyTableEntry &entry = keyTable->entries[i];
-			uint32_t ownerTag = FOURCC('?', '?', '?', '?');
-			if (chunkInfo.find(entry.castID) != chunkInfo.end()) {
-				ownerTag = chunkInfo[entry.castID].fourCC;
+		if (Common::g_verbose) {
+			for (size_t i = 0; i < keyTable->usedCount; i++) {
+				const KeyTableEntry &entry = keyTable->entries[i];
+				uint32_t ownerTag = FOURCC('?', '?', '?', '?');
+				if (chunkInfo.find(entry.castID) != chunkInfo.end()) {
+					ownerTag = chunkInfo[entry.castID].fourCC;
+				}
+				Common::debug(boost::format("KEY* entry %u: '%s' @ %d owned by '%s' @ %d")
+					% i % Common::fourCCToString(entry.fourCC) % entry.sectionID % Common::fourCCToString(ownerTag) % entry.castID);
 			}
-			Common::debug(boost::format("KEY* entry %u: '%s' @ %d owned by '%s' @ %d")
-				% i % Common::fourCCToString(entry.fourCC) % entry.sectionID % Common::fourCCToString(ownerTag) % entry.castID);
 		}
 
 		return true;
@@ -308,7 +414,8 @@ bool DirectorFile::readConfig() {
 	return false;
 }
 
-bool DirectorFile::readCasts() {
+std::vector<CastListing> DirectorFile::listCasts() {
+	std::vector<CastListing> listings;
 	bool internal = true;
 
 	if (version >= 500) {
@@ -316,7 +423,6 @@ bool DirectorFile::readCasts() {
 		if (info) {
 			CastListChunk *castList = static_cast<CastListChunk *>(getChunk(info->fourCC, info->id));
 			for (const auto &castEntry : castList->entries) {
-				Common::debug("Cast: " + castEntry.name);
 				int32_t sectionID = -1;
 				for (const auto &keyEntry : keyTable->entries) {
 					if (keyEntry.castID == castEntry.id && keyEntry.fourCC == FOURCC('C', 'A', 'S', '*')) {
@@ -324,14 +430,10 @@ bool DirectorFile::readCasts() {
 						break;
 					}
 				}
-				if (sectionID > 0) {
-					CastChunk *cast = static_cast<CastChunk *>(getChunk(FOURCC('C', 'A', 'S', '*'), sectionID));
-					cast->populate(castEntry.name, castEntry.id, castEntry.minMember);
-					casts.push_back(cast);
-				}
+				listings.push_back({ castEntry.name, castEntry.id, castEntry.minMember, sectionID });
 			}
 
-			return true;
+			return listings;
 		} else {
 			internal = false;
 		}
@@ -339,14 +441,50 @@ bool DirectorFile::readCasts() {
 
 	auto info = getFirstChunkInfo(FOURCC('C', 'A', 'S', '*'));
 	if (info) {
-		CastChunk *cast = static_cast<CastChunk *>(getChunk(info->fourCC, info->id));
-		cast->populate(internal ? "Internal" : "External", 1024, config->minMember);
-		casts.push_back(cast);
+		listings.push_back({ internal ? "Internal" : "External", 1024, (uint16_t)config->minMember, info->id });
+	}
+
+	return listings;
+}
+
+bool DirectorFile::readCasts() {
+	for (const CastListing &listing : listCasts()) {
+		Common::debug("Cast: " + listing.name);
+		if (listing.sectionID > 0) {
+			CastChunk *cast = static_cast<CastChunk *>(getChunk(FOURCC('C', 'A', 'S', '*'), listing.sectionID));
+			cast->populate(listing.name, listing.id, listing.minMember);
+			casts.push_back(cast);
+		}
 	}
 
 	return true;
 }
 
+// Resolves only the chunks one member needs: its cast's CAS*, its CASt, and
+// if it has a script, the cast's Lctx and Lnam and that one Lscr. Returns
+// nullptr if there is no such member.
+CastMemberChunk *DirectorFile::readMember(const std::string &castName, uint16_t memberID) {
+	std::vector<CastListing> listings = listCasts();
+	auto listing = std::find_if(listings.begin(), listings.end(), [&castName](const CastListing &l) {
+		return Common::compareIgnoreCase(l.name, castName) == 0;
+	});
+	if (listing == listings.end() || listing->sectionID <= 0)
+		return nullptr;
+
+	CastChunk *cast = static_cast<CastChunk *>(getChunk(FOURCC('C', 'A', 'S', '*'), listing->sectionID));
+	cast->name = listing->name;
+	cast->readContext(listing->id);
+	if (cast->lctx && version < 500) {
+		// Factories, a Director 4 feature, are attached to their parent
+		// script, so the whole context is needed to find them
+		cast->lctx->loadScripts();
+	}
+	CastMemberChunk *member = cast->readMember(memberID, listing->minMember);
+	if (member && std::find(casts.begin(), casts.end(), cast) == casts.end())
+		casts.push_back(cast);
+	return member;
+}
+
 const ChunkInfo *DirectorFile::getFirstChunkInfo(uint32_t fourCC) {
 	auto &chunkIDs = chunkIDsByFourCC[fourCC];
 	if (chunkIDs.size() > 0) {
@@ -371,9 +509,24 @@ Chunk *DirectorFile::getChunk(uint32_t fourCC, int32_t id) {
 
 	Common::BufferView chunkView = getChunkData(fourCC, id);
 	deserializedChunks[id] = makeChunk(fourCC, chunkView);
+	pinChunkBuf(id); // the chunk may hold views into its data
 	return deserializedChunks[id].get();
 }
 
+static void checkDecompressedLength(int32_t id, ssize_t actualLen, uint32_t expectedLen) {
+	if (actualLen == -1) {
+		throw std::runtime_error(boost::str(
+			boost::format("Chunk %d: Could not decompress") % id
+		));
+	}
+	if ((unsigned)actualLen != expectedLen) {
+		throw std::runtime_error(boost::str(
+			boost::format("Chunk %d: Expected uncompressed length %u but got length %zu")
+				% id % expectedLen % (unsigned)actualLen
+		));
+	}
+}
+
 Common::BufferView DirectorFile::getChunkData(uint32_t fourCC, int32_t id) {
 	if (chunkInfo.find(id) == chunkInfo.end())
 		throw std::runtime_error("Could not find chunk " + std::to_string(id));
@@ -387,9 +540,17 @@ Common::BufferView DirectorFile::getChunkData(uint32_t fourCC, int32_t id) {
 	}
 
 	if (_cachedChunkViews.find(id) != _cachedChunkViews.end()) {
+		touchChunkBuf(id);
 		return _cachedChunkViews[id];
 	}
 
+	if (_ilsInflater) {
+		if (!readILS(id))
+			throw std::runtime_error("ILS: Could not decompress");
+		if (_cachedChunkViews.find(id) != _cachedChunkViews.end())
+			return _cachedChunkViews[id];
+	}
+
 	if (afterburned) {
 		stream->seek(info.offset + _ilsBodyOffset);
 		if (info.len == 0 && info.uncompressedLen == 0) {
@@ -405,18 +566,14 @@ Common::BufferView DirectorFile::getChunkData(uint32_t fourCC, int32_t id) {
 				Common::WriteStream uncompStream(_cachedChunkBufs[id].data(), _cachedChunkBufs[id].size(), endianness);
 				actualUncompLength = decompressSnd(chunkStream, uncompStream, id);
 			}
-			if (actualUncompLength == -1) {
-				throw std::runtime_error(boost::str(
-					boost::format("Chunk %d: Could not decompress") % id
-				));
-			}
-			if ((unsigned)actualUncompLength != info.uncompressedLen) {
-				throw std::runtime_error(boost::str(
-					boost::format("Chunk %d: Expected uncompressed length %u but got length %zu")
-						% id % info.uncompressedLen % (unsigned)actualUncompLength
-				));
-			}
+			checkDecompressedLength(id, actualUncompLength, info.uncompressedLen);
 			_cachedChunkViews[id] = Common::BufferView(_cachedChunkBufs[id].data(), _cachedChunkBufs[id].size());
+
+			memory.allocate(chunkBufCategory(id), _cachedChunkBufs[id].size());
+			if (deserializedChunks.find(id) == deserializedChunks.end()) {
+				_evictableChunkPos[id] = _evictableChunks.insert(_evictableChunks.end(), id);
+				enforceMemoryBudget(id);
+			}
 		} else if (info.compressionID == FONTMAP_COMPRESSION_GUID) {
 			_cachedChunkViews[id] = getFontMap(version);
 		} else {
@@ -433,6 +590,55 @@ Common::BufferView DirectorFile::getChunkData(uint32_t fourCC, int32_t id) {
 	return _cachedChunkViews[id];
 }
 
+// memory budget
+
+Common::MemoryCategory DirectorFile::chunkBufCategory(int32_t id) {
+	return (chunkInfo[id].compressionID == SND_COMPRESSION_GUID)
+		? Common::kMemoryDecodedSound
+		: Common::kMemoryInflatedChunks;
+}
+
+void DirectorFile::touchChunkBuf(int32_t id) {
+	auto it = _evictableChunkPos.find(id);
+	if (it != _evictableChunkPos.end()) {
+		_evictableChunks.splice(_evictableChunks.end(), _evictableChunks, it->second);
+	}
+}
+
+void DirectorFile::pinChunkBuf(int32_t id) {
+	auto it = _evictableChunkPos.find(id);
+	if (it != _evictableChunkPos.end()) {
+		_evictableChunks.erase(it->second);
+		_evictableChunkPos.erase(it);
+	}
+}
+
+void DirectorFile::evictChunkBuf(int32_t id) {
+	Common::debug(boost::format("Evicting inflated chunk %d (%zu bytes)") % id % _cachedChunkBufs[id].size());
+	pinChunkBuf(id);
+	memory.release(chunkBufCategory(id), _cachedChunkBufs[id].size());
+	_cachedChunkViews.erase(id);
+	_cachedChunkBufs.erase(id);
+}
+
+void DirectorFile::enforceMemoryBudget(int32_t keepID) {
+	if (memoryBudget == 0)
+		return;
+
+	// Views returned by getChunkData for chunks which haven't been
+	// deserialized are only valid until something else inflates or decodes
+	// a chunk when a budget is set: getChunkData, write, or script rendering.
+	auto it = _evictableChunks.begin();
+	while (memory.live(Common::kMemoryInflatedChunks) + memory.live(Common::kMemoryDecodedSound) > memoryBudget
+			&& it != _evictableChunks.end()) {
+		int32_t id = *it;
+		++it;
+		if (id != keepID) {
+			evictChunkBuf(id);
+		}
+	}
+}
+
 std::shared_ptr<Chunk> DirectorFile::readChunk(uint32_t fourCC, uint32_t len) {
 	Common::BufferView chunkView = readChunkData(fourCC, len);
 	Common::ReadStream chunkStream(chunkView, endianness);
@@ -513,7 +719,9 @@ std::shared_ptr<Chunk> DirectorFile::makeChunk(uint32_t fourCC, const Common::Bu
 }
 
 LingoDec::Script *DirectorFile::getScript(int32_t id) {
-	return static_cast<ScriptChunk *>(getChunk(FOURCC('L', 's', 'c', 'r'), id));
+	LingoDec::Script *script = static_cast<ScriptChunk *>(getChunk(FOURCC('L', 's', 'c', 'r'), id));
+	_scriptChunkIDs[script] = id;
+	return script;
 }
 
 LingoDec::ScriptNames *DirectorFile::getScriptNames(int32_t id) {
@@ -530,12 +738,17 @@ bool DirectorFile::compressionImplemented(MoaID compressionID) {
 // write stuff
 
 void DirectorFile::writeToFile(const std::filesystem::path &path) {
+	std::vector<uint8_t> buf = writeToBuffer();
+	IO::writeFile(path, buf.data(), buf.size());
+}
+
+std::vector<uint8_t> DirectorFile::writeToBuffer() {
 	generateInitialMap();
 	generateMemoryMap();
 	std::vector<uint8_t> buf(size());
 	Common::WriteStream stream(buf.data(), buf.size(), endianness);
 	write(stream);
-	IO::writeFile(path, stream);
+	return buf;
 }
 
 void DirectorFile::generateInitialMap() {
@@ -668,15 +881,125 @@ void DirectorFile::write(Common::WriteStream &stream) {
 	writeChunk(stream, 1); // Write imap
 	writeChunk(stream, 2); // Write mmap
 
+	std::vector<SoundJob> sounds;
 	for (auto [id, info] : chunkInfo) {
 		if (id <= 2) // Ignore RIFX, imap, mmap
 			continue;
 
-		writeChunk(stream, id);
+		writeChunk(stream, id, &sounds);
 	}
+	decodeSounds(sounds);
 }
 
-void DirectorFile::writeChunk(Common::WriteStream &stream, int32_t id) {
+/* SoundJob */
+
+// A compressed sound chunk which write() decodes straight into its place in
+// the output, so the decoded sound is never held anywhere else
+struct SoundJob {
+	int32_t id;
+	Common::BufferView in;
+	uint8_t *out;
+	uint32_t len;
+	ssize_t actualLen = -1;
+
+	void decode(Common::Endianness endianness) {
+		Common::ReadStream chunkStream(in, endianness);
+		Common::WriteStream uncompStream(out, len, endianness);
+		actualLen = decompressSnd(chunkStream, uncompStream, id);
+	}
+};
+
+// Runs work(0) to work(count - 1) on the pool, or on this thread if there is
+// none, then calls finish for each on this thread, in order. Messages logged by each job are
+// passed on just before its finish, and a job that throws stops the rest
+// from finishing with the same error.
+static void runJobs(IO::ThreadPool *pool, size_t count, const std::function<void(size_t)> &work, const std::function<void(size_t)> &finish) {
+	if (!pool || pool->size() <= 1 || count <= 1) {
+		for (size_t i = 0; i < count; i++) {
+			work(i);
+			finish(i);
+		}
+		return;
+	}
+
+	struct JobLog {
+		std::string error;
+		std::vector<std::pair<bool, std::string>> messages;
+	};
+	std::vector<JobLog> logs(count);
+	for (size_t i = 0; i < count; i++) {
+		pool->enqueue([&work, &log = logs[i], i]() {
+			Common::setThreadLogHandler([&log](bool isWarning, const std::string &msg) {
+				log.messages.emplace_back(isWarning, msg);
+			});
+			try {
+				work(i);
+			} catch (const std::exception &e) {
+				log.error = e.what();
+			}
+			Common::setThreadLogHandler(nullptr);
+		});
+	}
+	pool->wait();
+
+	for (size_t i = 0; i < count; i++) {
+		for (const auto &[isWarning, msg] : logs[i].messages) {
+			if (isWarning)
+				Common::warning(msg);
+			else
+				Common::log(msg);
+		}
+		if (!logs[i].error.empty())
+			throw std::runtime_error(logs[i].error);
+		finish(i);
+	}
+}
+
+// Whether a chunk is a compressed sound that hasn't been decoded yet, so its
+// MP3 data can be decoded straight to where it's needed
+bool DirectorFile::isUndecodedSound(int32_t id) {
+	const ChunkInfo &info = chunkInfo[id];
+	return afterburned && !_ilsInflater
+		&& info.compressionID == SND_COMPRESSION_GUID && info.uncompressedLen != 0
+		&& _cachedChunkViews.find(id) == _cachedChunkViews.end();
+}
+
+// Decodes the sounds left by writeChunk, on soundPool if there is one.
+// The first chunk that fails throws the same error getChunkData would.
+// Sounds being decoded count as decoded sound memory. With a memory budget
+// they're decoded in batches that fit in it, one sound at least, and cached
+// chunk buffers are evicted to make room for each batch.
+void DirectorFile::decodeSounds(std::vector<SoundJob> &sounds) {
+	size_t start = 0;
+	while (start < sounds.size()) {
+		size_t end = start;
+		size_t batchLen = 0;
+		while (end < sounds.size()
+				&& (memoryBudget == 0 || end == start || batchLen + sounds[end].len <= memoryBudget)) {
+			batchLen += sounds[end].len;
+			end++;
+		}
+
+		memory.allocate(Common::kMemoryDecodedSound, batchLen);
+		enforceMemoryBudget(-1);
+		try {
+			runJobs(soundPool, end - start,
+				[this, &sounds, start](size_t i) { sounds[start + i].decode(endianness); },
+				[&sounds, start](size_t i) {
+					const SoundJob &job = sounds[start + i];
+					checkDecompressedLength(job.id, job.actualLen, job.len);
+				}
+			);
+		} catch (...) {
+			memory.release(Common::kMemoryDecodedSound, batchLen);
+			throw;
+		}
+		memory.release(Common::kMemoryDecodedSound, batchLen);
+		start = end;
+	}
+}
+
+void DirectorFile::writeChunk(Common::WriteStream &stream, int32_t id, std::vector<SoundJob> *sounds) {
 	auto &mapEntry = memoryMap->mapArray[id];
 
 	stream.endianness = endianness;
@@ -707,6 +1030,18 @@ void DirectorFile::writeChunk(Common::WriteStream &stream, int32_t id) {
 	}
 	if (chunk && chunk->writable) {
 		chunk->write(stream);
+	} else if (sounds && isUndecodedSound(id)) {
+		const ChunkInfo &info = chunkInfo[id];
+		if (stream.pos() + info.uncompressedLen > stream.size())
+			throw std::runtime_error("Chunk " + std::to_string(id) + " doesn't fit in the output");
+		SoundJob job;
+		job.id = id;
+		this->stream->seek(info.offset + _ilsBodyOffset);
+		job.in = this->stream->readByteView(info.len);
+		job.out = stream.data() + stream.pos();
+		job.len = info.uncompressedLen;
+		sounds->push_back(std::move(job));
+		stream.skip(info.uncompressedLen);
 	} else {
 		stream.writeBytes(getChunkData(mapEntry.fourCC, id));
 	}
@@ -722,12 +1057,138 @@ void DirectorFile::writeChunk(Common::WriteStream &stream, int32_t id) {
 // restoration
 
 void DirectorFile::parseScripts() {
+	// With a cache, scripts are parsed by renderScript only if they miss
+	if (scriptCache)
+		return;
+
+	size_t nodesBefore = LingoDec::Node::liveCount;
 	for (const auto &cast : casts) {
 		if (!cast->lctx)
 			continue;
 
 		cast->lctx->parseScripts();
 	}
+	memory.allocate(Common::kMemoryAST, (LingoDec::Node::liveCount - nodesBefore) * kASTNodeSizeEstimate);
+}
+
+void DirectorFile::parseScript(LingoDec::Script *script) {
+	size_t nodesBefore = LingoDec::Node::liveCount;
+	script->parse();
+	for (LingoDec::Script *factory : script->factories) {
+		factory->parse();
+	}
+	memory.allocate(Common::kMemoryAST, (LingoDec::Node::liveCount - nodesBefore) * kASTNodeSizeEstimate);
+}
+
+// Name IDs a script and its handlers may refer to. Every bytecode operand is
+// included, since an operand that isn't a name only makes the key stricter.
+static void collectNameIDs(const LingoDec::Script *script, std::set<int32_t> &nameIDs) {
+	nameIDs.insert(script->propertyNameIDs.begin(), script->propertyNameIDs.end());
+	nameIDs.insert(script->globalNameIDs.begin(), script->globalNameIDs.end());
+	if (script->isFactory())
+		nameIDs.insert(script->factoryNameID);
+	for (const auto &handler : script->handlers) {
+		nameIDs.insert(handler->nameID);
+		nameIDs.insert(handler->argumentNameIDs.begin(), handler->argumentNameIDs.end());
+		nameIDs.insert(handler->localNameIDs.begin(), handler->localNameIDs.end());
+		nameIDs.insert(handler->globalNameIDs.begin(), handler->globalNameIDs.end());
+		for (const LingoDec::Bytecode &bytecode : handler->bytecodeArray) {
+			nameIDs.insert(bytecode.obj);
+		}
+	}
+}
+
+// The key covers everything the rendered text depends on: the bytecode of
+// the script and its factories, the names they refer to, and how the text is
+// rendered. Only the referenced names are included, so adding a script to a
+// movie, which adds names to the shared name table, doesn't change the key of
+// every other script. The build is included so a persistent cache isn't
+// reused by a version that would decompile differently.
+Common::Hash128 DirectorFile::scriptCacheKey(LingoDec::Script *script, const char *lineEnding, bool bytecode) {
+	std::string key = "ProjectorRays " STR(VERSION_NUMBER) "-" STR(GIT_SHA);
+	key += '\0';
+	key += std::to_string(version) + (dotSyntax ? " dot " : " verbose ") + (bytecode ? "bytecode " : "script ");
+	key += lineEnding;
+	key += '\0';
+
+	std::set<int32_t> nameIDs;
+	auto appendScript = [&](LingoDec::Script *s) {
+		collectNameIDs(s, nameIDs);
+		auto it = _scriptChunkIDs.find(s);
+		if (it == _scriptChunkIDs.end())
+			return;
+
+		Common::BufferView view = getChunkData(FOURCC('L', 's', 'c', 'r'), it->second);
+		key += std::to_string(view.size());
+		key += '\0';
+		size_t start = key.size();
+		key.append(reinterpret_cast<const char *>(view.data()), view.size());
+
+		// The script's number, its parent's number, and its cast member
+		// don't affect the text, and would keep copies of a script at
+		// different positions from matching
+		static const size_t positionFields[][2] = { { 18, 2 }, { 22, 2 }, { 44, 4 } };
+		for (const auto &field : positionFields) {
+			if (field[0] + field[1] <= view.size())
+				key.replace(start + field[0], field[1], field[1], '\0');
+		}
+	};
+	appendScript(script);
+	for (LingoDec::Script *factory : script->factories) {
+		appendScript(factory);
+	}
+
+	const LingoDec::ScriptNames *lnam = script->context->lnam;
+	for (int32_t id : nameIDs) {
+		key += std::to_string(id);
+		if (lnam && lnam->validName(id)) {
+			key += '=';
+			key += std::to_string(lnam->names[id].size());
+			key += '\0';
+			key += lnam->names[id];
+		} else {
+			key += '?'; // would render as UNKNOWN_NAME, so it must not match a real name
+		}
+	}
+
+	return Common::murmurHash3(key.data(), key.size());
+}
+
+void DirectorFile::countScriptCacheLookup(const LingoDec::Script *script, bool hit) {
+	auto it = _scriptCacheMissed.find(script);
+	if (it == _scriptCacheMissed.end()) {
+		_scriptCacheMissed[script] = !hit;
+		if (hit)
+			scriptCacheHits++;
+		else
+			scriptCacheMisses++;
+	} else if (!hit && !it->second) {
+		it->second = true;
+		scriptCacheHits--;
+		scriptCacheMisses++;
+	}
+}
+
+std::string DirectorFile::renderScript(LingoDec::Script *script, const char *lineEnding, bool bytecode) {
+	Common::Hash128 key;
+	if (scriptCache) {
+		key = scriptCacheKey(script, lineEnding, bytecode);
+		std::string text;
+		bool hit = scriptCache->find(key, text);
+		countScriptCacheLookup(script, hit);
+		if (hit)
+			return text;
+
+		IO::StageTimer timer(scriptParseTime);
+		parseScript(script);
+	}
+
+	std::string text = bytecode
+		? script->bytecodeText(lineEnding, dotSyntax)
+		: script->scriptText(lineEnding, dotSyntax);
+	if (scriptCache)
+		scriptCache->insert(key, text);
+	return text;
 }
 
 void DirectorFile::restoreScriptText() {
@@ -738,7 +1199,9 @@ void DirectorFile::restoreScriptText() {
 		for (auto [scriptId, script] : cast->lctx->scripts) {
 			CastMemberChunk *member = static_cast<ScriptChunk *>(script)->member;
 			if (member) {
-				member->setScriptText(script->scriptText("\r", dotSyntax));
+				std::string text = renderScript(script, "\r");
+				memory.allocate(Common::kMemoryRenderedText, text.size());
+				member->setScriptText(std::move(text));
 			}
 		}
 	}
@@ -752,44 +1215,118 @@ void DirectorFile::dumpScripts(fs::path castsDir) {
 			continue;
 
 		fs::path castDir = castsDir / IO::cleanFileName(cast->name);
-		fs::create_directory(castDir);
+		IO::createDirectory(castDir);
 
 		for (auto it = cast->lctx->scripts.begin(); it != cast->lctx->scripts.end(); ++it) {
-			std::string scriptType;
-			std::string id;
 			CastMemberChunk *member = static_cast<ScriptChunk *>(it->second)->member;
 			if (!member)
 				continue;
 
-			if (member->type == kScriptMember) {
-				ScriptMember *scriptMember = static_cast<ScriptMember *>(member->member.get());
-				switch (scriptMember->scriptType) {
-				case kScoreScript:
-					scriptType = (version >= 600) ? "BehaviorScript" : "ScoreScript";
-					break;
-				case kMovieScript:
-					scriptType = "MovieScript";
-					break;
-				case kParentScript:
-					scriptType = "ParentScript";
-					break;
-				default:
-					scriptType = "UnknownScript";
-					break;
-				}
-			} else {
-				scriptType = "CastScript";
-			}
-			id = std::to_string(member->id);
+			std::string scriptType = scriptTypeName(member);
+			std::string id = std::to_string(member->id);
 			if (!member->getName().empty()) {
 				id += " - " + member->getName();
 			}
 
 			std::string fileName = IO::cleanFileName(scriptType + " " + id);
-			IO::writeFile(castDir / (fileName + ".ls"), it->second->scriptText(IO::kPlatformLineEnding, dotSyntax));
-			IO::writeFile(castDir / (fileName + ".lasm"), it->second->bytecodeText(IO::kPlatformLineEnding, dotSyntax));
+			std::string scriptText = renderScript(it->second, IO::kPlatformLineEnding);
+			std::string bytecodeText = renderScript(it->second, IO::kPlatformLineEnding, true);
+			size_t textSize = scriptText.size() + bytecodeText.size();
+			memory.allocate(Common::kMemoryRenderedText, textSize);
+			IO::writeFile(castDir / (fileName + ".ls"), scriptText);
+			IO::writeFile(castDir / (fileName + ".lasm"), bytecodeText);
+			memory.release(Common::kMemoryRenderedText, textSize);
+		}
+	}
+}
+
+void DirectorFile::dumpSounds(fs::path castsDir, SoundFileFormat format) {
+	// Sound members own their 'snd ' chunk in the key table
+	std::map<int32_t, int32_t> soundIDs;
+	for (const auto &entry : keyTable->entries) {
+		if (entry.fourCC == FOURCC('s', 'n', 'd', ' ') && chunkExists(entry.fourCC, entry.sectionID))
+			soundIDs[entry.castID] = entry.sectionID;
+	}
+
+	struct SoundExport {
+		int32_t id;
+		bool compressed;
+		Common::BufferView data;
+		fs::path path;
+		uint64_t bytesWritten = 0;
+	};
+	std::vector<SoundExport> sounds;
+	const char *extension = (format == kSoundFileWAV) ? ".wav" : ".aiff";
+	for (const auto &cast : casts) {
+		fs::path castDir = castsDir / IO::cleanFileName(cast->name);
+		bool castDirCreated = false;
+
+		for (int32_t sectionID : cast->memberIDs) {
+			auto chunkIt = deserializedChunks.find(sectionID);
+			auto soundIt = soundIDs.find(sectionID);
+			if (chunkIt == deserializedChunks.end() || soundIt == soundIDs.end())
+				continue;
+			CastMemberChunk *member = static_cast<CastMemberChunk *>(chunkIt->second.get());
+			if (member->type != kSoundMember)
+				continue;
+
+			if (!castDirCreated) {
+				IO::createDirectory(castDir);
+				castDirCreated = true;
+			}
+			std::string id = std::to_string(member->id);
+			if (!member->getName().empty()) {
+				id += " - " + member->getName();
+			}
+
+			SoundExport sound;
+			sound.id = soundIt->second;
+			sound.compressed = isUndecodedSound(sound.id);
+			sound.path = castDir / (IO::cleanFileName("Sound " + id) + extension);
+			sounds.push_back(std::move(sound));
 		}
 	}
+
+	// A sink takes files from one thread, and evicting a chunk buffer under a
+	// memory budget would pull the data out from under a worker, so those
+	// export one sound at a time.
+	IO::ThreadPool *pool = (IO::threadFileSink() || memoryBudget != 0) ? nullptr : soundPool;
+	bool threaded = pool && pool->size() > 1 && sounds.size() > 1;
+	auto soundData = [this](const SoundExport &sound) {
+		if (!sound.compressed)
+			return getChunkData(FOURCC('s', 'n', 'd', ' '), sound.id);
+		const ChunkInfo &info = chunkInfo[sound.id];
+		stream->seek(info.offset + _ilsBodyOffset);
+		return stream->readByteView(info.len);
+	};
+	if (threaded) {
+		for (SoundExport &sound : sounds) {
+			sound.data = soundData(sound);
+		}
+	}
+
+	runJobs(pool, sounds.size(),
+		[&](size_t i) {
+			SoundExport &sound = sounds[i];
+			Common::ReadStream soundStream(threaded ? sound.data : soundData(sound), endianness);
+			IO::FileWriter file;
+			if (!file.open(sound.path)) {
+				Common::warning("Could not write " + sound.path.string());
+				return;
+			}
+			uint64_t startBytes = IO::g_bytesWritten;
+			// exportSnd warns of what it couldn't read
+			exportSnd(soundStream, sound.compressed, format, file, sound.id);
+			if (!file.close())
+				Common::warning("Could not write " + sound.path.string());
+			sound.bytesWritten = IO::g_bytesWritten - startBytes;
+		},
+		[&](size_t i) {
+			// Count the bytes the workers wrote on this thread
+			if (threaded)
+				IO::g_bytesWritten += sounds[i].bytesWritten;
+		}
+	);
 }
 
 void DirectorFile::dumpChunks(fs::path chunksDir) {
@@ -818,6 +1355,24 @@ void DirectorFile::dumpJSON(fs::path chunksDir) {
 	}
 }
 
+std::string DirectorFile::scriptTypeName(const CastMemberChunk *member) const {
+	if (member->type != kScriptMember)
+		return "CastScript";
+
+	const ScriptMember *scriptMember = static_cast<const ScriptMember *>(member->member.get());
+	switch (scriptMember->scriptType) {
+	case kScoreScript:
+		return (version >= 600) ? "BehaviorScript" : "ScoreScript";
+	case kMovieScript:
+		return "MovieScript";
+	case kParentScript:
+		return "ParentScript";
+	default:
+		break;
+	}
+	return "UnknownScript";
+}
+
 bool DirectorFile::isCast() const {
 	return codec == FOURCC('M', 'C', '9', '5') || codec == FOURCC('F', 'G', 'D', 'C');
 }
@@ -10,23 +10,35 @@
 #include <cstdint>
 #include <istream>
 #include <filesystem>
+#include <list>
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "common/hash.h"
+#include "common/memory.h"
 #include "common/stream.h"
 #include "director/guid.h"
+#include "director/sound.h"
 #include "lingodec/resolver.h"
 
+namespace IO {
+class ScriptCache;
+class ThreadPool;
+}
+
 namespace Director {
 
 struct Chunk;
 struct CastChunk;
+struct CastMemberChunk;
 struct ConfigChunk;
 struct KeyTableChunk;
 struct InitialMapChunk;
 struct MemoryMapChunk;
+struct ILSInflater;
+struct SoundJob;
 
 struct ChunkInfo {
 	int32_t id;
@@ -37,14 +49,50 @@ struct ChunkInfo {
 	MoaID compressionID;
 };
 
+// A cast as listed by the movie, before its members are read
+struct CastListing {
+	std::string name;
+	int32_t id;
+	uint16_t minMember;
+	int32_t sectionID; // of its CAS* chunk, or -1 if it has none
+};
+
 class DirectorFile : public LingoDec::ChunkResolver {
 private:
 	size_t _ilsBodyOffset;
 	std::vector<uint8_t> _ilsBuf;
+	std::unique_ptr<ILSInflater> _ilsInflater; // until the whole ILS has been read
+	size_t _ilsParsed;
+
+	bool readILS(int32_t untilID);
 
 	std::map<int32_t, std::vector<uint8_t>> _cachedChunkBufs;
 	std::map<int32_t, Common::BufferView> _cachedChunkViews;
 
+	// Inflated chunk buffers which no deserialized chunk refers to,
+	// least recently used first. These may be evicted and re-inflated.
+	std::list<int32_t> _evictableChunks;
+	std::map<int32_t, std::list<int32_t>::iterator> _evictableChunkPos;
+
+	Common::MemoryCategory chunkBufCategory(int32_t id);
+	void touchChunkBuf(int32_t id);
+	void pinChunkBuf(int32_t id);
+	void evictChunkBuf(int32_t id);
+	void enforceMemoryBudget(int32_t keepID);
+
+	bool isUndecodedSound(int32_t id);
+	void decodeSounds(std::vector<SoundJob> &sounds);
+
+	Common::Hash128 scriptCacheKey(LingoDec::Script *script, const char *lineEnding, bool bytecode);
+
+	// The Lscr chunk each script resolved by a context was read from
+	std::map<const LingoDec::Script *, int32_t> _scriptChunkIDs;
+
+	// Whether each script looked up in the cache missed in any of its
+	// renderings, so the hits and misses count scripts, not lookups
+	std::map<const LingoDec::Script *, bool> _scriptCacheMissed;
+	void countScriptCacheLookup(const LingoDec::Script *script, bool hit);
+
 public:
 	Common::ReadStream *stream;
 	KeyTableChunk *keyTable;
@@ -66,6 +114,29 @@ public:
 	std::unique_ptr<InitialMapChunk> initialMap;
 	std::unique_ptr<MemoryMapChunk> memoryMap;
 
+	Common::MemoryTracker memory;
+	size_t memoryBudget; // Budget for evictable chunk buffers in bytes, 0 for none
+
+	// If set, read() doesn't populate the casts, script contexts don't load
+	// their scripts, and an Afterburner file's initial load segment is only
+	// inflated as far as the chunks requested. Use readMember to resolve
+	// single members.
+	bool lazyCasts;
+
+	// If set, write() and dumpSounds() decode compressed sounds on it. It
+	// may be shared by files processed one after another, so its threads'
+	// MP3 decoders are reused.
+	IO::ThreadPool *soundPool;
+
+	// If set, rendered script text is looked up here by content before a
+	// script is parsed, and scripts are only parsed when they miss. A script
+	// is counted as a hit only if every rendering of it hit.
+	IO::ScriptCache *scriptCache;
+	size_t scriptCacheHits;
+	size_t scriptCacheMisses;
+	// Seconds renderScript spent parsing scripts that missed the cache
+	double scriptParseTime;
+
 	DirectorFile();
 	virtual ~DirectorFile();
 
@@ -74,7 +145,9 @@ public:
 	bool readAfterburnerMap();
 	bool readKeyTable();
 	bool readConfig();
+	std::vector<CastListing> listCasts();
 	bool readCasts();
+	CastMemberChunk *readMember(const std::string &castName, uint16_t memberID);
 	const ChunkInfo *getFirstChunkInfo(uint32_t fourCC);
 	bool chunkExists(uint32_t fourCC, int32_t id);
 	Chunk *getChunk(uint32_t fourCC, int32_t id);
@@ -91,18 +164,24 @@ public:
 	size_t chunkSize(int32_t id);
 
 	void writeToFile(const std::filesystem::path &path);
+	std::vector<uint8_t> writeToBuffer();
 	void generateInitialMap();
 	void generateMemoryMap();
 	void write(Common::WriteStream &stream);
-	void writeChunk(Common::WriteStream &stream, int32_t id);
+	void writeChunk(Common::WriteStream &stream, int32_t id, std::vector<SoundJob> *sounds = nullptr);
 
 	void parseScripts();
+	void parseScript(LingoDec::Script *script);
+	std::string renderScript(LingoDec::Script *script, const char *lineEnding, bool bytecode = false);
 	void restoreScriptText();
 
 	void dumpScripts(std::filesystem::path castsDir);
+	void dumpSounds(std::filesystem::path castsDir, SoundFileFormat format);
 	void dumpChunks(std::filesystem::path chunksDir);
 	void dumpJSON(std::filesystem::path chunksDir);
 
+	std::string scriptTypeName(const CastMemberChunk *member) const;
+
 	bool isCast() const;
 };
 
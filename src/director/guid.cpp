@@ -22,6 +22,15 @@ void MoaID::read(Common::ReadStream &stream) {
 	}
 }
 
+void MoaID::write(Common::WriteStream &stream) const {
+	stream.writeUint32(data1);
+	stream.writeUint16(data2);
+	stream.writeUint16(data3);
+	for (size_t i = 0; i < 8; i++) {
+		stream.writeUint8(data4[i]);
+	}
+}
+
 std::string MoaID::toString() const {
 	return boost::str(
 		boost::format("%08X-%04X-%04X-%02X%02X-%02X%02X%02X%02X%02X%02X")
@@ -49,4 +58,16 @@ bool MoaID::operator!=(const MoaID &other) const {
 	return !operator==(other);
 }
 
+std::string compressionName(const MoaID &compressionID) {
+	if (compressionID == ZLIB_COMPRESSION_GUID)
+		return "zlib";
+	if (compressionID == SND_COMPRESSION_GUID)
+		return "snd";
+	if (compressionID == FONTMAP_COMPRESSION_GUID)
+		return "fontmap";
+	if (compressionID == NULL_COMPRESSION_GUID)
+		return "none";
+	return "unknown";
+}
+
 } // namespace Director
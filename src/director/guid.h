@@ -12,6 +12,7 @@
 
 namespace Common {
 class ReadStream;
+class WriteStream;
 }
 
 namespace Director {
@@ -43,6 +44,7 @@ struct MoaID {
 	}
 
 	void read(Common::ReadStream &stream);
+	void write(Common::WriteStream &stream) const;
 	std::string toString() const;
 
 	bool operator==(const MoaID &other) const;
@@ -54,6 +56,8 @@ struct MoaID {
 #define SND_COMPRESSION_GUID MoaID(0x7204A889, 0xAFD0, 0x11CF, 0xA2, 0x22, 0x00, 0xA0, 0x24, 0x53, 0x44, 0x4C)
 #define ZLIB_COMPRESSION_GUID MoaID(0xAC99E904, 0x0070, 0x0B36, 0x00, 0x00, 0x08, 0x00, 0x07, 0x37, 0x7A, 0x34)
 
+std::string compressionName(const MoaID &compressionID);
+
 } // namespace Director
 
 #endif // DIRECTOR_GUID_H
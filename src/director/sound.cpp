@@ -4,7 +4,9 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include <algorithm>
 #include <iostream>
+#include <mutex>
 #include <string>
 
 #include <boost/format.hpp>
@@ -13,6 +15,7 @@
 #include "common/log.h"
 #include "common/stream.h"
 #include "director/sound.h"
+#include "io/fileio.h"
 
 namespace Director {
 
@@ -24,17 +27,90 @@ off_t ReadStream_lseek(void *stream, off_t offset, int whence) {
 	return ((Common::ReadStream *)stream)->lseek(offset, whence);
 }
 
+/* MP3Decoder */
+
+// An mpg123 handle, created and configured once per thread and reused for
+// every chunk the thread decodes. Only the output format changes between
+// chunks; the flags and the reader functions stay set.
+class MP3Decoder {
+private:
+	mpg123_handle *_mh = nullptr;
+
+public:
+	MP3Decoder() = default;
+	MP3Decoder(const MP3Decoder &) = delete;
+	MP3Decoder &operator=(const MP3Decoder &) = delete;
+	~MP3Decoder() { reset(); }
+
+	// Returns null if the handle can't be created
+	mpg123_handle *acquire();
+	// Deletes the handle after an error, so the next chunk starts afresh
+	void reset();
+};
+
+static thread_local MP3Decoder t_decoder;
+
+mpg123_handle *MP3Decoder::acquire() {
+	if (_mh)
+		return _mh;
+
+	// initialize mpg123 (required for compatibility with older mpg123 versions,
+	// where it also isn't thread-safe, so only do it once)
+	static std::once_flag initFlag;
+	static int initErr = MPG123_OK;
+	std::call_once(initFlag, []() { initErr = mpg123_init(); });
+	int err = initErr;
+	if (err != MPG123_OK) {
+		Common::warning(boost::format("mpg123_init: %s") % mpg123_plain_strerror(err));
+		return nullptr;
+	}
+
+	// initialize an mpg123 handle
+	mpg123_handle *mh = mpg123_new(NULL, &err);
+	if (!mh) {
+		Common::warning(boost::format("mpg123_new: %s") % mpg123_plain_strerror(err));
+		return nullptr;
+	}
+
+	// set format restrictions
+	int flags = MPG123_FORCE_ENDIAN | MPG123_BIG_ENDIAN; // big endian output
+	flags |= MPG123_NO_FRANKENSTEIN; // don't allow change of format
+	err = mpg123_param(mh, MPG123_FLAGS, flags, 0.0);
+	if (err == MPG123_OK) {
+		// set mpg123 to use our ReadStream functions
+		err = mpg123_replace_reader_handle(mh, ReadStream_read, ReadStream_lseek, NULL);
+	}
+	if (err != MPG123_OK) {
+		Common::warning(boost::format("mpg123 setup: %s") % mpg123_plain_strerror(err));
+		mpg123_delete(mh);
+		return nullptr;
+	}
+
+	_mh = mh;
+	return _mh;
+}
+
+void MP3Decoder::reset() {
+	if (_mh) {
+		mpg123_delete(_mh);
+		_mh = nullptr;
+	}
+}
+
 #define CHECK_ERR(name) \
 	do { \
 		if (err != MPG123_OK && err != MPG123_DONE) { \
 			Common::warning(boost::format(name": %s") % mpg123_plain_strerror(err)); \
 			mpg123_close(mh); \
-			mpg123_delete(mh); \
+			t_decoder.reset(); \
 			return false; \
 		} \
 	} while (0)
 
-size_t samplesToBytes(size_t samples, int channels, int sampleSize) {
+// One MPEG-1 layer III frame of 16-bit stereo
+static const size_t kSkipScratchSize = 1152 * 2 * 2;
+
+static size_t samplesToBytes(size_t samples, int channels, int sampleSize) {
 	size_t bytes = samples;
 	if (channels == 2) {
 		bytes *= 2;
@@ -45,40 +121,19 @@ size_t samplesToBytes(size_t samples, int channels, int sampleSize) {
 	return bytes;
 }
 
-bool decodeMP3(
+// Opens MP3 data on mh, checks that it decodes to the format the header
+// gives, and discards the samples to skip
+static bool openMP3(
+	mpg123_handle *mh,
 	Common::ReadStream &in,
-	Common::WriteStream &out,
 	int hdrSampleRate,
 	int hdrChannels,
 	int hdrSampleSize,
-	size_t hdrSkipSamples,
-	int32_t chunkID
+	size_t hdrSkipSamples
 ) {
-	size_t bytesToRead = out.size() - out.pos();
-	Common::debug(boost::format("Chunk %d: Decoding %zu bytes of MP3 data (rate: %d channels: %d bitdepth: %d)")
-					% chunkID % bytesToRead % hdrSampleRate % hdrChannels % hdrSampleSize);
-
-	int err;
-	mpg123_handle *mh;
-
-	// initialize mpg123 (required for compatibility with older mpg123 versions)
-	err = mpg123_init();
-	if (err != MPG123_OK) {
-		Common::warning(boost::format("mpg123_init: %s") % mpg123_plain_strerror(err));
-		return false;
-	}
-
-	// initialize an mpg123 handle
-	if ((mh = mpg123_new(NULL, &err)) == NULL) {
-		Common::warning(boost::format("mpg123_new: %s") % mpg123_plain_strerror(err));
-		return false;
-	}
-
-	// clear its supported formats
-	err = mpg123_format_none(mh);
+	// set the format specified by the header, clearing the last chunk's
+	int err = mpg123_format_none(mh);
 	CHECK_ERR("mpg123_format_none");
-
-	// set the format specified by the header
 	int expectedEncoding = (hdrSampleSize == 8) ? MPG123_ENC_UNSIGNED_8 : MPG123_ENC_SIGNED_16;
 	err = mpg123_format(
 		mh, hdrSampleRate,
@@ -87,16 +142,6 @@ bool decodeMP3(
 	);
 	CHECK_ERR("mpg123_format");
 
-	// set other format restrictions
-	int flags = MPG123_FORCE_ENDIAN | MPG123_BIG_ENDIAN; // big endian output
-	flags |= MPG123_NO_FRANKENSTEIN; // don't allow change of format
-	mpg123_param(mh, MPG123_FLAGS, flags, 0.0);
-	CHECK_ERR("mpg123_param");
-
-	// set mpg123 to use our ReadStream functions
-	err = mpg123_replace_reader_handle(mh, ReadStream_read, ReadStream_lseek, NULL);
-	CHECK_ERR("mpg123_replace_reader_handle");
-
 	// now begin reading from the stream
 	err = mpg123_open_handle(mh, &in);
 	CHECK_ERR("mpg123_open_handle");
@@ -109,160 +154,165 @@ bool decodeMP3(
 	if (outputSampleRate != hdrSampleRate) {
 		Common::warning(boost::format("Output sample rate (%ld) doesn't match header sample rate (%d)!")
 						% outputSampleRate % hdrSampleRate);
+		mpg123_close(mh);
 		return false;
 	}
 	if (outputChannels != hdrChannels) {
 		Common::warning(boost::format("Output channels (%d) doesn't match header channels (%d)!")
 						% outputChannels % hdrChannels);
+		mpg123_close(mh);
 		return false;
 	}
 	if (outputEncoding != expectedEncoding) {
 		Common::warning(boost::format("Output encoding (%d) doesn't match header sample size (%d)!")
 						% outputEncoding % hdrSampleSize);
+		mpg123_close(mh);
 		return false;
 	}
 
+	// Decode the skipped samples a piece at a time and discard them. Seeking
+	// would avoid decoding them, but mpg123 resumes from a frame boundary with
+	// an approximate bit reservoir, so the samples after it could differ.
 	size_t done;
 	size_t bytesToSkip = samplesToBytes(hdrSkipSamples, hdrChannels, hdrSampleSize);
-	std::vector<uint8_t> garbage(bytesToSkip);
+	uint8_t scratch[kSkipScratchSize];
 	while (bytesToSkip && err != MPG123_DONE) {
-		err = mpg123_read(mh, garbage.data(), garbage.size(), &done);
+		err = mpg123_read(mh, scratch, std::min(bytesToSkip, sizeof(scratch)), &done);
 		CHECK_ERR("mpg123_read");
 		bytesToSkip -= done;
 	}
 
-	while (bytesToRead && err != MPG123_DONE) {
-		err = mpg123_read(mh, &out.data()[out.pos()], bytesToRead, &done);
-		out.skip(done);
+	return true;
+}
+
+// Decodes up to len bytes into buf, stopping short only if the data ends
+static bool readMP3(mpg123_handle *mh, uint8_t *buf, size_t len, size_t &done) {
+	int err = MPG123_OK;
+	done = 0;
+	while (done < len && err != MPG123_DONE) {
+		size_t count;
+		err = mpg123_read(mh, buf + done, len - done, &count);
+		done += count;
 		CHECK_ERR("mpg123_read");
-		bytesToRead -= done;
 	}
+	return true;
+}
+
+bool decodeMP3(
+	Common::ReadStream &in,
+	Common::WriteStream &out,
+	int hdrSampleRate,
+	int hdrChannels,
+	int hdrSampleSize,
+	size_t hdrSkipSamples,
+	int32_t chunkID
+) {
+	size_t bytesToRead = out.size() - out.pos();
+	Common::debug(boost::format("Chunk %d: Decoding %zu bytes of MP3 data (rate: %d channels: %d bitdepth: %d)")
+					% chunkID % bytesToRead % hdrSampleRate % hdrChannels % hdrSampleSize);
+
+	mpg123_handle *mh = t_decoder.acquire();
+	if (!mh)
+		return false;
+	if (!openMP3(mh, in, hdrSampleRate, hdrChannels, hdrSampleSize, hdrSkipSamples))
+		return false;
+
+	size_t done;
+	if (!readMP3(mh, &out.data()[out.pos()], bytesToRead, done))
+		return false;
+	out.skip(done);
 
 	mpg123_close(mh);
-	mpg123_delete(mh);
 
 	return true;
 }
 
-ssize_t decompressSnd(Common::ReadStream &in, Common::WriteStream &out, int32_t chunkID) {
-	if (in.size() == 0)
-		return 0;
-
-	in.endianness = Common::kBigEndian;
-	out.endianness = Common::kBigEndian;
+// The fields of a sound header that describe its samples
+struct SoundHeader {
+	uint16_t sampleRate;
+	uint16_t sampleRateFrac;
+	uint32_t numSamples; // sample frames
+	uint32_t numChannels;
+	uint16_t sampleSize;
+};
 
+// Reads a 'snd ' resource up to the start of its samples
+static bool readSndHeader(Common::ReadStream &in, SoundHeader &header) {
 	// 'snd ' header
 	// https://developer.apple.com/library/archive/documentation/mac/Sound/Sound-60.html
 
 	uint16_t format = in.readUint16();
-	out.writeUint16(format);
-
 	if (format == 1) {
 		// Format 1
 		uint16_t dataFormatCount = in.readUint16();
-		out.writeUint16(dataFormatCount);
-
 		for (uint16_t i = 0; i < dataFormatCount; i++) {
-			uint16_t dataFormatID = in.readUint16();
-			out.writeUint16(dataFormatID);
-
-			uint32_t initOption = in.readUint32();
-			out.writeUint32(initOption);
+			in.readUint16(); // dataFormatID
+			in.readUint32(); // initOption
 		}
 	} else {
 		// Format 2
-		uint16_t referenceCount = in.readUint16();
-		out.writeUint16(referenceCount);
+		in.readUint16(); // referenceCount
 	}
 
 	uint16_t soundCommandCount = in.readUint16();
-	out.writeUint16(soundCommandCount);
-
 	for (uint16_t i = 0; i < soundCommandCount; i++) {
-		uint16_t cmd = in.readUint16();
-		out.writeUint16(cmd);
-
-		uint16_t param1 = in.readUint16();
-		out.writeUint16(param1);
-
-		uint32_t param2 = in.readUint32();
-		out.writeUint32(param2);
+		in.readUint16(); // cmd
+		in.readUint16(); // param1
+		in.readUint32(); // param2
 	}
 
 	// sound header record
 	// https://developer.apple.com/library/archive/documentation/mac/Sound/Sound-74.html
 	// https://developer.apple.com/library/archive/documentation/mac/Sound/Sound-75.html
 
-	uint32_t samplePtr = in.readUint32();
-	out.writeUint32(samplePtr);
-
+	in.readUint32(); // samplePtr
 	uint32_t encodeDependent = in.readUint32();
-	out.writeUint32(encodeDependent);
-
-	uint16_t sampleRate = in.readUint16();
-	out.writeUint16(sampleRate);
-
-	uint16_t sampleRateFrac = in.readUint16();
-	out.writeUint16(sampleRateFrac);
-
-	uint32_t loopStart = in.readUint32();
-	out.writeUint32(loopStart);
-
-	uint32_t loopEnd = in.readUint32();
-	out.writeUint32(loopEnd);
-
+	header.sampleRate = in.readUint16();
+	header.sampleRateFrac = in.readUint16();
+	in.readUint32(); // loopStart
+	in.readUint32(); // loopEnd
 	uint8_t encode = in.readUint8();
-	out.writeUint8(encode);
-
-	uint8_t baseFrequency = in.readUint8();
-	out.writeUint8(baseFrequency);
-
-	uint32_t numSamples;
-	uint32_t numChannels;
-	uint16_t sampleSize;
+	in.readUint8(); // baseFrequency
 
 	if (encode == 0x00) {
 		// Standard header
-		numSamples = encodeDependent;
-		numChannels = 1;
-		sampleSize = 8;
+		header.numSamples = encodeDependent;
+		header.numChannels = 1;
+		header.sampleSize = 8;
 	} else if (encode == 0xFF || encode == 0xFD) {
 		// Extended header
-		numChannels = encodeDependent;
-
-		numSamples = in.readUint32();
-		out.writeUint32(numSamples);
-
-		Common::BufferView AIFFSampleRate = in.readByteView(10);
-		out.writeBytes(AIFFSampleRate);
-
-		uint32_t markerChunk = in.readUint32();
-		out.writeUint32(markerChunk);
-
-		uint32_t instrumentChunks = in.readUint32();
-		out.writeUint32(instrumentChunks);
-
-		uint32_t AESRecording = in.readUint32();
-		out.writeUint32(AESRecording);
-
-		sampleSize = in.readUint16();
-		out.writeUint16(sampleSize);
+		header.numChannels = encodeDependent;
+		header.numSamples = in.readUint32();
+		in.skip(10); // AIFFSampleRate
+		in.readUint32(); // markerChunk
+		in.readUint32(); // instrumentChunks
+		in.readUint32(); // AESRecording
+		header.sampleSize = in.readUint16();
+		in.readUint16(); // futureUse1
+		in.readUint32(); // futureUse2
+		in.readUint32(); // futureUse3
+		in.readUint32(); // futureUse4
+	} else {
+		Common::warning(boost::format("Unhandled sound encode option 0x%02X!") % (unsigned int)encode);
+		return false;
+	}
 
-		uint16_t futureUse1 = in.readUint16();
-		out.writeUint16(futureUse1);
+	return true;
+}
 
-		uint32_t futureUse2 = in.readUint32();
-		out.writeUint32(futureUse2);
+ssize_t decompressSnd(Common::ReadStream &in, Common::WriteStream &out, int32_t chunkID) {
+	if (in.size() == 0)
+		return 0;
 
-		uint32_t futureUse3 = in.readUint32();
-		out.writeUint32(futureUse3);
+	in.endianness = Common::kBigEndian;
+	out.endianness = Common::kBigEndian;
 
-		uint32_t futureUse4 = in.readUint32();
-		out.writeUint32(futureUse4);
-	} else {
-		Common::warning(boost::format("Unhandled sound encode option 0x%02X!") % (unsigned int)encode);
+	// The header is copied as it is
+	size_t headerStart = in.pos();
+	SoundHeader header;
+	if (!readSndHeader(in, header))
 		return -1;
-	}
+	out.writeBytes(in.data() + headerStart, in.pos() - headerStart);
 
 	// skip samples
 
@@ -272,10 +322,162 @@ ssize_t decompressSnd(Common::ReadStream &in, Common::WriteStream &out, int32_t
 
 	Common::BufferView mp3View = in.readByteView(in.size() - in.pos());
 	Common::ReadStream mp3Stream(mp3View, in.endianness);
-	if (!decodeMP3(mp3Stream, out, sampleRate, numChannels, sampleSize, skipSamples, chunkID))
+	if (!decodeMP3(mp3Stream, out, header.sampleRate, header.numChannels, header.sampleSize, skipSamples, chunkID))
 		return -1;
 
 	return out.size();
 }
 
+/* exporting */
+
+static const size_t kExportBlockSize = 65536;
+
+static const size_t kWAVHeaderSize = 44;
+static const size_t kAIFFHeaderSize = 54;
+
+// Writes a 16.16 fixed point rate as an 80-bit IEEE extended float
+static void writeExtended(Common::WriteStream &stream, uint32_t fixed) {
+	if (fixed == 0) {
+		stream.writeUint16(0);
+		stream.writeUint32(0);
+		stream.writeUint32(0);
+		return;
+	}
+	int topBit = 31;
+	while (!(fixed & (1U << topBit))) {
+		topBit--;
+	}
+	uint64_t mantissa = (uint64_t)fixed << (63 - topBit);
+	stream.writeUint16(16383 + topBit - 16);
+	stream.writeUint32(mantissa >> 32);
+	stream.writeUint32(mantissa & 0xFFFFFFFF);
+}
+
+// Writes the header of a file holding dataSize bytes of samples, returning
+// its size
+static size_t writeSoundFileHeader(uint8_t *buf, SoundFileFormat format, const SoundHeader &header, uint32_t dataSize) {
+	uint32_t paddedSize = dataSize + (dataSize & 1); // chunks are word aligned
+	uint16_t blockAlign = samplesToBytes(1, header.numChannels, header.sampleSize);
+	if (format == kSoundFileWAV) {
+		uint32_t sampleRate = (((uint32_t)header.sampleRate << 16) + header.sampleRateFrac + 0x8000) >> 16;
+		Common::WriteStream stream(buf, kWAVHeaderSize, Common::kLittleEndian);
+		stream.writeBytes("RIFF", 4);
+		stream.writeUint32(4 + 8 + 16 + 8 + paddedSize);
+		stream.writeBytes("WAVE", 4);
+		stream.writeBytes("fmt ", 4);
+		stream.writeUint32(16);
+		stream.writeUint16(1); // PCM
+		stream.writeUint16(header.numChannels);
+		stream.writeUint32(sampleRate);
+		stream.writeUint32(sampleRate * blockAlign);
+		stream.writeUint16(blockAlign);
+		stream.writeUint16(header.sampleSize);
+		stream.writeBytes("data", 4);
+		stream.writeUint32(dataSize);
+		return stream.pos();
+	}
+
+	Common::WriteStream stream(buf, kAIFFHeaderSize, Common::kBigEndian);
+	stream.writeBytes("FORM", 4);
+	stream.writeUint32(4 + 8 + 18 + 8 + 8 + paddedSize);
+	stream.writeBytes("AIFF", 4);
+	stream.writeBytes("COMM", 4);
+	stream.writeUint32(18);
+	stream.writeUint16(header.numChannels);
+	stream.writeUint32(header.numSamples);
+	stream.writeUint16(header.sampleSize);
+	writeExtended(stream, ((uint32_t)header.sampleRate << 16) | header.sampleRateFrac);
+	stream.writeBytes("SSND", 4);
+	stream.writeUint32(8 + dataSize);
+	stream.writeUint32(0); // offset
+	stream.writeUint32(0); // blockSize
+	return stream.pos();
+}
+
+// Converts big endian samples, as a 'snd ' resource holds them, for the file.
+// WAV wants little endian 16-bit samples, and AIFF signed 8-bit ones.
+static void convertSamples(uint8_t *data, size_t size, SoundFileFormat format, uint16_t sampleSize) {
+	if (format == kSoundFileWAV && sampleSize == 16) {
+		Common::swapBytes16(data, size);
+	} else if (format == kSoundFileAIFF && sampleSize == 8) {
+		for (size_t i = 0; i < size; i++) {
+			data[i] ^= 0x80;
+		}
+	}
+}
+
+bool exportSnd(Common::ReadStream &in, bool compressed, SoundFileFormat format, IO::FileWriter &out, int32_t chunkID) {
+	in.endianness = Common::kBigEndian;
+
+	SoundHeader header;
+	if (!readSndHeader(in, header))
+		return false;
+	if ((header.numChannels != 1 && header.numChannels != 2) || (header.sampleSize != 8 && header.sampleSize != 16)) {
+		Common::warning(boost::format("Chunk %d: Can't export %u channels of %u-bit samples")
+						% chunkID % header.numChannels % header.sampleSize);
+		return false;
+	}
+	size_t dataSize = samplesToBytes(header.numSamples, header.numChannels, header.sampleSize);
+	if (dataSize > UINT32_MAX - kAIFFHeaderSize) {
+		Common::warning(boost::format("Chunk %d: Sound is too long to export") % chunkID);
+		return false;
+	}
+
+	uint8_t block[kExportBlockSize];
+	size_t headerSize = writeSoundFileHeader(block, format, header, dataSize);
+	out.write(block, headerSize);
+
+	if (compressed) {
+		uint32_t skipSamples = in.readUint32();
+		Common::BufferView mp3View = in.readByteView(in.size() - in.pos());
+		Common::ReadStream mp3Stream(mp3View, in.endianness);
+
+		mpg123_handle *mh = t_decoder.acquire();
+		if (!mh)
+			return false;
+		if (!openMP3(mh, mp3Stream, header.sampleRate, header.numChannels, header.sampleSize, skipSamples))
+			return false;
+
+		size_t bytesLeft = dataSize;
+		bool ended = false;
+		while (bytesLeft) {
+			size_t len = std::min(bytesLeft, sizeof(block));
+			size_t done = 0;
+			if (!ended && !readMP3(mh, block, len, done))
+				return false;
+			if (done < len) {
+				if (!ended) {
+					Common::warning(boost::format("Chunk %d: MP3 data ended %zu bytes early, padding with silence")
+									% chunkID % (bytesLeft - done));
+					ended = true;
+				}
+				std::fill(block + done, block + len, (header.sampleSize == 8) ? 0x80 : 0);
+			}
+			convertSamples(block, len, format, header.sampleSize);
+			out.write(block, len);
+			bytesLeft -= len;
+		}
+		mpg123_close(mh);
+	} else {
+		if (in.size() - in.pos() < dataSize) {
+			Common::warning(boost::format("Chunk %d: Sound holds %zu bytes of samples, expected %zu")
+							% chunkID % (in.size() - in.pos()) % dataSize);
+			return false;
+		}
+		const uint8_t *samples = in.data() + in.pos();
+		for (size_t pos = 0; pos < dataSize; pos += sizeof(block)) {
+			size_t len = std::min(dataSize - pos, sizeof(block));
+			std::copy(samples + pos, samples + pos + len, block);
+			convertSamples(block, len, format, header.sampleSize);
+			out.write(block, len);
+		}
+	}
+
+	if (dataSize & 1) {
+		uint8_t pad = 0;
+		out.write(&pad, 1);
+	}
+	return true;
+}
+
 } // namespace Director
@@ -9,15 +9,30 @@
 
 #include <sys/types.h> // for ssize_t. not portable...
 
+#include <cstdint>
+
 namespace Common {
 class ReadStream;
 class WriteStream;
 }
 
+namespace IO {
+class FileWriter;
+}
+
 namespace Director {
 
+enum SoundFileFormat {
+	kSoundFileWAV,
+	kSoundFileAIFF
+};
+
 ssize_t decompressSnd(Common::ReadStream &in, Common::WriteStream &out, int32_t castID);
 
+// Writes a 'snd ' resource's samples as a WAV or AIFF file. If compressed is
+// set, its MP3 data is decoded a block at a time as the file is written.
+bool exportSnd(Common::ReadStream &in, bool compressed, SoundFileFormat format, IO::FileWriter &out, int32_t chunkID);
+
 } // namespace Director
 
 #endif // DIRECTOR_SOUND_H
@@ -29,12 +29,13 @@ void CastListEntry::writeJSON(Common::JSONWriter &json) const {
 /* MemoryMapEntry */
 
 void MemoryMapEntry::read(Common::ReadStream &stream) {
-	fourCC = stream.readUint32();
-	len = stream.readUint32();
-	offset = stream.readUint32();
-	flags = stream.readInt16();
-	unknown0 = stream.readInt16();
-	next = stream.readInt32();
+	Common::ReadCursor entry = stream.reserve(20);
+	fourCC = entry.readUint32();
+	len = entry.readUint32();
+	offset = entry.readUint32();
+	flags = entry.readInt16();
+	unknown0 = entry.readInt16();
+	next = entry.readInt32();
 }
 
 void MemoryMapEntry::write(Common::WriteStream &stream) {
@@ -60,9 +61,16 @@ void MemoryMapEntry::writeJSON(Common::JSONWriter &json) const {
 /* KeyTableEntry */
 
 void KeyTableEntry::read(Common::ReadStream &stream) {
-	sectionID = stream.readInt32();
-	castID = stream.readInt32();
-	fourCC = stream.readUint32();
+	Common::ReadCursor entry = stream.reserve(12);
+	sectionID = entry.readInt32();
+	castID = entry.readInt32();
+	fourCC = entry.readUint32();
+}
+
+void KeyTableEntry::write(Common::WriteStream &stream) {
+	stream.writeInt32(sectionID);
+	stream.writeInt32(castID);
+	stream.writeUint32(fourCC);
 }
 
 void KeyTableEntry::writeJSON(Common::JSONWriter &json) const {
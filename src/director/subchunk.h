@@ -48,6 +48,7 @@ struct KeyTableEntry {
 	uint32_t fourCC;
 
 	void read(Common::ReadStream &stream);
+	void write(Common::WriteStream &stream);
 	void writeJSON(Common::JSONWriter &json) const;
 };
 
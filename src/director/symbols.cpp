@@ -0,0 +1,152 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "common/stream.h"
+#include "common/util.h"
+#include "director/chunk.h"
+#include "director/dirfile.h"
+#include "director/symbols.h"
+#include "lingodec/ast.h"
+#include "lingodec/handler.h"
+#include "lingodec/names.h"
+#include "lingodec/script.h"
+
+namespace Director {
+
+static void addSymbol(SymbolSet &symbols, IO::SymbolKind kind, const std::string &name) {
+	if (!name.empty())
+		symbols.emplace(kind, Common::toLowercase(name));
+}
+
+static void addName(SymbolSet &symbols, IO::SymbolKind kind, const LingoDec::Script &script, int32_t nameID) {
+	if (script.validName(nameID))
+		addSymbol(symbols, kind, script.getName(nameID));
+}
+
+static void addLiteral(SymbolSet &symbols, IO::SymbolKind kind, const std::shared_ptr<LingoDec::Datum> &datum) {
+	if (!datum)
+		return;
+	if (datum->type == LingoDec::kDatumString) {
+		addSymbol(symbols, kind, datum->s);
+	} else if (datum->type == LingoDec::kDatumInt) {
+		addSymbol(symbols, kind, std::to_string(datum->i));
+	}
+}
+
+static std::shared_ptr<LingoDec::Datum> literalAt(const LingoDec::Script &script, LingoDec::Handler &handler, const LingoDec::Bytecode &bytecode) {
+	if (bytecode.opcode == LingoDec::kOpPushCons) {
+		int literalID = bytecode.obj / handler.variableMultiplier();
+		if (-1 < literalID && (unsigned)literalID < script.literals.size())
+			return script.literals[literalID].value;
+	} else if (bytecode.opcode == LingoDec::kOpPushInt8 || bytecode.opcode == LingoDec::kOpPushInt16 || bytecode.opcode == LingoDec::kOpPushInt32) {
+		return std::make_shared<LingoDec::Datum>(bytecode.obj);
+	}
+	return nullptr;
+}
+
+static void collectHandlerSymbols(LingoDec::Script &script, LingoDec::Handler &handler, bool parsed, SymbolSet &symbols) {
+	using namespace LingoDec;
+
+	addSymbol(symbols, IO::kSymbolHandler, handler.name);
+	for (const std::string &global : handler.globalNames) {
+		addSymbol(symbols, IO::kSymbolGlobal, global);
+	}
+
+	const std::vector<Bytecode> &bytecodes = handler.bytecodeArray;
+	for (size_t i = 0; i < bytecodes.size(); i++) {
+		const Bytecode &bytecode = bytecodes[i];
+		switch (bytecode.opcode) {
+		case kOpExtCall:
+		case kOpTellCall:
+		case kOpObjCall:
+		case kOpNewObj:
+			addName(symbols, IO::kSymbolCall, script, bytecode.obj);
+			// castLib("name") or castLib(number) is a literal, a one-item
+			// arglist, then the call
+			if (bytecode.opcode == kOpExtCall && i >= 2 && bytecodes[i - 1].opcode == kOpPushArgList && bytecodes[i - 1].obj == 1
+					&& script.validName(bytecode.obj) && Common::compareIgnoreCase(script.getName(bytecode.obj), "castLib") == 0) {
+				addLiteral(symbols, IO::kSymbolCastLib, literalAt(script, handler, bytecodes[i - 2]));
+			}
+			break;
+		case kOpLocalCall:
+			if (-1 < bytecode.obj && (unsigned)bytecode.obj < script.handlers.size())
+				addSymbol(symbols, IO::kSymbolCall, script.handlers[bytecode.obj]->name);
+			break;
+		case kOpGetGlobal:
+		case kOpGetGlobal2:
+		case kOpSetGlobal:
+		case kOpSetGlobal2:
+			addName(symbols, IO::kSymbolGlobal, script, bytecode.obj);
+			break;
+		case kOpGetProp:
+		case kOpSetProp:
+		case kOpGetObjProp:
+		case kOpSetObjProp:
+		case kOpGetChainedProp:
+		case kOpGetMovieProp:
+		case kOpSetMovieProp:
+		case kOpGetTopLevelProp:
+		case kOpTheBuiltin:
+			addName(symbols, IO::kSymbolProperty, script, bytecode.obj);
+			break;
+		case kOpPushSymb:
+			addName(symbols, IO::kSymbolSymbol, script, bytecode.obj);
+			break;
+		case kOpPushCons:
+			{
+				auto datum = literalAt(script, handler, bytecode);
+				if (datum && datum->type == kDatumString)
+					addSymbol(symbols, IO::kSymbolString, datum->s);
+			}
+			break;
+		default:
+			break;
+		}
+
+		// Parsing resolves member expressions, whose cast is often a literal
+		if (parsed && bytecode.translation && bytecode.translation->type == kMemberExprNode) {
+			auto member = std::static_pointer_cast<MemberExprNode>(bytecode.translation);
+			auto castLib = (member->type == "castLib") ? member->memberID : member->castID;
+			if (castLib && castLib->type == kLiteralNode)
+				addLiteral(symbols, IO::kSymbolCastLib, castLib->getValue());
+		}
+	}
+}
+
+void collectSymbols(DirectorFile &dir, bool parse, SymbolSet &symbols) {
+	for (const CastListing &listing : dir.listCasts()) {
+		if (listing.sectionID <= 0)
+			continue;
+
+		CastChunk *cast = static_cast<CastChunk *>(dir.getChunk(FOURCC('C', 'A', 'S', '*'), listing.sectionID));
+		cast->readContext(listing.id);
+		if (!cast->lctx)
+			continue;
+
+		cast->lctx->loadScripts();
+		if (cast->lctx->lnam) {
+			for (const std::string &name : cast->lctx->lnam->names) {
+				addSymbol(symbols, IO::kSymbolName, name);
+			}
+		}
+		for (const auto &[number, script] : cast->lctx->scripts) {
+			if (parse)
+				dir.parseScript(script);
+
+			for (const std::string &property : script->propertyNames) {
+				addSymbol(symbols, IO::kSymbolProperty, property);
+			}
+			for (const std::string &global : script->globalNames) {
+				addSymbol(symbols, IO::kSymbolGlobal, global);
+			}
+			for (const auto &handler : script->handlers) {
+				collectHandlerSymbols(*script, *handler, parse, symbols);
+			}
+		}
+	}
+}
+
+} // namespace Director
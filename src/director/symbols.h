@@ -0,0 +1,30 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef DIRECTOR_SYMBOLS_H
+#define DIRECTOR_SYMBOLS_H
+
+#include <set>
+#include <string>
+#include <utility>
+
+#include "io/symbolindex.h"
+
+namespace Director {
+
+class DirectorFile;
+
+typedef std::set<std::pair<IO::SymbolKind, std::string>> SymbolSet;
+
+// Adds the symbols used by every script in the file, lowercased since Lingo
+// is case-insensitive. Only names and bytecode operands are read, unless
+// parse is set, in which case the scripts are decompiled so that castLibs in
+// member expressions are found too.
+void collectSymbols(DirectorFile &dir, bool parse, SymbolSet &symbols);
+
+} // namespace Director
+
+#endif // DIRECTOR_SYMBOLS_H
@@ -40,6 +40,37 @@ unsigned int humanVersion(unsigned int ver) {
 	return 200;
 }
 
+unsigned int rawVersion(unsigned int humanVer) {
+	// Inverse of humanVersion, giving the lowest raw version for each release
+	if (humanVer >= 1200)
+		return 1951;
+	if (humanVer >= 1150)
+		return 1922;
+	if (humanVer >= 1100)
+		return 1921;
+	if (humanVer >= 1000)
+		return 1851;
+	if (humanVer >= 850)
+		return 1700;
+	if (humanVer >= 800)
+		return 1410;
+	if (humanVer >= 700)
+		return 1224;
+	if (humanVer >= 600)
+		return 1218;
+	if (humanVer >= 500)
+		return 1201;
+	if (humanVer >= 404)
+		return 1117;
+	if (humanVer >= 400)
+		return 1115;
+	if (humanVer >= 310)
+		return 1029;
+	if (humanVer >= 300)
+		return 1028;
+	return 0;
+}
+
 std::string versionNumber(unsigned int ver, const std::string &fverVersionString) {
 	unsigned int major = ver / 100;
 	unsigned int minor = (ver / 10) % 10;
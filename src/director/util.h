@@ -12,6 +12,7 @@
 namespace Director {
 
 unsigned int humanVersion(unsigned int ver);
+unsigned int rawVersion(unsigned int humanVer);
 std::string versionNumber(unsigned int ver, const std::string &fverVersionString);
 std::string versionString(unsigned int ver, const std::string &fverVersionString);
 
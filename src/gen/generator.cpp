@@ -0,0 +1,1102 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <climits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <zlib.h>
+
+#include "common/stream.h"
+#include "common/util.h"
+#include "director/castmember.h"
+#include "director/chunk.h"
+#include "director/dirfile.h"
+#include "director/guid.h"
+#include "director/subchunk.h"
+#include "director/util.h"
+#include "gen/generator.h"
+#include "lingodec/enums.h"
+
+namespace Gen {
+
+using namespace LingoDec;
+using Director::MoaID;
+
+static const size_t kRIFXHeaderSize = 12;
+static const size_t kChunkHeaderSize = 8;
+static const size_t kInitialMapSize = 24;
+static const size_t kMemoryMapHeaderSize = 24;
+static const size_t kMemoryMapEntrySize = 20;
+static const size_t kScriptHeaderSize = 92;
+static const size_t kScriptContextHeaderSize = 42;
+static const size_t kScriptNamesHeaderSize = 20;
+static const size_t kBitmapSpecificDataSize = 28;
+
+// Fcdr compression table
+enum CompressionIndex {
+	kIndexZlib,
+	kIndexSnd,
+	kIndexNull
+};
+
+// MPEG-1 layer III, 128 kbps, 44.1 kHz, mono: 417 bytes and 1152 samples per frame
+static const uint8_t kMP3FrameHeader[4] = { 0xFF, 0xFB, 0x90, 0xC0 };
+static const size_t kMP3FrameSize = 417;
+static const size_t kMP3FrameSamples = 1152;
+static const uint32_t kSoundSampleRate = 44100;
+
+static const char *kDefaultHandlerNames[] = {
+	"startMovie", "exitFrame", "mouseUp", "mouseDown",
+	"enterFrame", "beginSprite", "endSprite", "idle"
+};
+static const char *kLocalNames[] = { "i", "count", "total", "label", "ratio", "index" };
+static const char *kArgumentNames[] = { "me", "value" };
+static const char *kGlobalNames[] = { "gScore", "gLevel", "gPlayerName" };
+static const char *kPropertyNames[] = { "pSpeed", "pState" };
+static const char *kCallNames[] = { "alert", "beep", "updateStage", "random", "doUpdate", "playCue" };
+static const char *kWords[] = {
+	"alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel",
+	"india", "juliet", "kilo", "lima", "mike", "november", "oscar", "papa"
+};
+
+template<typename T, size_t N>
+static constexpr size_t countOf(T (&)[N]) { return N; }
+
+static const size_t kLocalCount = countOf(kLocalNames);
+static const size_t kArgumentCount = countOf(kArgumentNames);
+static const size_t kGlobalCount = countOf(kGlobalNames);
+static const size_t kPropertyCount = countOf(kPropertyNames);
+static const size_t kCallCount = countOf(kCallNames);
+static const size_t kRandomCall = 3;
+
+static std::vector<uint8_t> compressZlib(const std::vector<uint8_t> &data, int level) {
+	uLongf len = compressBound(data.size());
+	std::vector<uint8_t> res(len);
+	if (compress2(res.data(), &len, data.data(), data.size(), level) != Z_OK)
+		throw std::runtime_error("Could not compress chunk");
+	res.resize(len);
+	return res;
+}
+
+/* Bytecode helpers */
+
+static void writeOp(std::vector<uint8_t> &code, uint8_t op) {
+	code.push_back(op);
+}
+
+static void writeOp(std::vector<uint8_t> &code, uint8_t op, int32_t obj) {
+	// Pick the narrowest operand that holds the value, as the compiler does
+	bool isSigned = (op == kOpPushInt8);
+	if (isSigned ? (obj >= INT8_MIN && obj <= INT8_MAX) : (obj >= 0 && obj <= UINT8_MAX)) {
+		code.push_back(op);
+		code.push_back((uint8_t)obj);
+	} else if (isSigned ? (obj >= INT16_MIN && obj <= INT16_MAX) : (obj >= 0 && obj <= UINT16_MAX)) {
+		code.push_back(op + 0x40);
+		code.push_back((uint8_t)(obj >> 8));
+		code.push_back((uint8_t)obj);
+	} else {
+		code.push_back(op + 0x80);
+		code.push_back((uint8_t)(obj >> 24));
+		code.push_back((uint8_t)(obj >> 16));
+		code.push_back((uint8_t)(obj >> 8));
+		code.push_back((uint8_t)obj);
+	}
+}
+
+static void writeJump(std::vector<uint8_t> &code, uint8_t op, const std::vector<uint8_t> &body) {
+	size_t dist = 2 + body.size();
+	if (dist > UINT8_MAX)
+		dist++;
+	writeOp(code, op, dist);
+	code.insert(code.end(), body.begin(), body.end());
+}
+
+/* Generator */
+
+Generator::Generator(const GeneratorOptions &options) :
+	_options(options),
+	_dir(std::make_unique<Director::DirectorFile>()),
+	_totalSize(0),
+	_ilsLen(0),
+	_abHeaderSize(0) {
+	if (_options.version < 500)
+		throw std::runtime_error("Only Director 5 and later movies can be generated");
+	if (_options.handlersPerScript == 0)
+		throw std::runtime_error("Scripts need at least one handler");
+	if ((uint64_t)_options.soundSkipSamples > (uint64_t)_options.soundFrames * kMP3FrameSamples)
+		throw std::runtime_error("Sounds can't skip more samples than their frames hold");
+
+	// Chunk writers consult the movie for its version and byte order
+	_dir->version = _options.version;
+	_dir->endianness = _options.endianness;
+
+	for (unsigned int i = 0; i < _options.handlersPerScript; i++) {
+		if (i < countOf(kDefaultHandlerNames)) {
+			_names.push_back(kDefaultHandlerNames[i]);
+		} else {
+			_names.push_back("handler" + std::to_string(i));
+		}
+	}
+	_names.insert(_names.end(), std::begin(kLocalNames), std::end(kLocalNames));
+	_names.insert(_names.end(), std::begin(kArgumentNames), std::end(kArgumentNames));
+	_names.insert(_names.end(), std::begin(kGlobalNames), std::end(kGlobalNames));
+	_names.insert(_names.end(), std::begin(kPropertyNames), std::end(kPropertyNames));
+	_names.insert(_names.end(), std::begin(kCallNames), std::end(kCallNames));
+
+	plan();
+}
+
+Generator::~Generator() = default;
+
+// planning
+
+void Generator::plan() {
+	_chunks.clear();
+	_casts.clear();
+
+	addChunk(FOURCC('K', 'E', 'Y', '*'), kKindKeyTable, 0, 0, true);
+	addChunk(FOURCC('D', 'R', 'C', 'F'), kKindConfig, 0, 0, true);
+	addChunk(FOURCC('M', 'C', 's', 'L'), kKindCastList, 0, 0, true);
+
+	unsigned int memberCount = _options.scriptsPerCast + _options.bitmapsPerCast + _options.soundsPerCast;
+	_casts.resize(_options.castCount);
+	for (unsigned int c = 0; c < _options.castCount; c++) {
+		GenCast &cast = _casts[c];
+		cast.listID = 1024 + c;
+		cast.castChunkID = addChunk(FOURCC('C', 'A', 'S', '*'), kKindCast, c, 0, true);
+		cast.lctxID = addChunk(FOURCC('L', 'c', 't', 'x'), kKindScriptContext, c, 0, true);
+		cast.lnamID = addChunk(FOURCC('L', 'n', 'a', 'm'), kKindScriptNames, c, 0, true);
+		for (unsigned int m = 0; m < memberCount; m++) {
+			cast.memberIDs.push_back(addChunk(FOURCC('C', 'A', 'S', 't'), kKindCastMember, c, m, false));
+			switch (memberKind(m)) {
+			case kMemberScript:
+				cast.scriptIDs.push_back(addChunk(FOURCC('L', 's', 'c', 'r'), kKindScript, c, m, false));
+				cast.dataIDs.push_back(-1);
+				break;
+			case kMemberBitmap:
+				cast.dataIDs.push_back(addChunk(FOURCC('B', 'I', 'T', 'D'), kKindBitmapData, c, m, false));
+				break;
+			case kMemberSound:
+				cast.dataIDs.push_back(addChunk(FOURCC('s', 'n', 'd', ' '), kKindSound, c, m, false));
+				break;
+			}
+		}
+	}
+
+	if (_options.container == kContainerRIFX) {
+		planRIFX();
+	} else {
+		planAfterburner();
+	}
+
+	if (_totalSize > INT32_MAX) {
+		throw std::runtime_error("Generated movie would exceed the 2 GiB limit of the file format");
+	}
+}
+
+int32_t Generator::addChunk(uint32_t fourCC, ChunkKind kind, unsigned int castIndex, unsigned int index, bool inILS) {
+	GenChunk chunk;
+	chunk.id = 3 + _chunks.size(); // 0-2 are RIFX, imap and mmap (or the ILS)
+	chunk.fourCC = fourCC;
+	chunk.kind = kind;
+	chunk.castIndex = castIndex;
+	chunk.index = index;
+	chunk.inILS = inILS;
+	chunk.compressionType = kIndexNull;
+	chunk.len = 0;
+	chunk.uncompressedLen = 0;
+	chunk.offset = 0;
+	_chunks.push_back(chunk);
+	return chunk.id;
+}
+
+void Generator::planRIFX() {
+	size_t offset = kRIFXHeaderSize;
+	offset += kChunkHeaderSize + kInitialMapSize;
+	offset += kChunkHeaderSize + kMemoryMapHeaderSize + (_chunks.size() + 3) * kMemoryMapEntrySize;
+
+	for (auto &chunk : _chunks) {
+		chunk.len = chunkData(chunk).size();
+		chunk.uncompressedLen = chunk.len;
+		chunk.offset = offset;
+		offset += kChunkHeaderSize + chunk.len;
+	}
+	_totalSize = offset;
+}
+
+void Generator::planAfterburner() {
+	// Metadata goes into the initial load segment, everything else follows it
+	std::vector<uint8_t> ils;
+	for (auto &chunk : _chunks) {
+		if (!chunk.inILS)
+			continue;
+
+		std::vector<uint8_t> data = chunkData(chunk);
+		chunk.len = data.size();
+		chunk.uncompressedLen = data.size();
+		chunk.compressionType = kIndexNull;
+
+		std::vector<uint8_t> idBuf(Common::WriteStream::varIntSize(chunk.id));
+		Common::WriteStream idStream(idBuf.data(), idBuf.size(), _options.endianness);
+		idStream.writeVarInt(chunk.id);
+		ils.insert(ils.end(), idBuf.begin(), idBuf.end());
+		ils.insert(ils.end(), data.begin(), data.end());
+	}
+	_ilsLen = ils.size();
+	_ilsData = compressZlib(ils, _options.compressionLevel);
+
+	size_t offset = _ilsData.size();
+	for (auto &chunk : _chunks) {
+		if (chunk.inILS)
+			continue;
+
+		if (chunk.kind == kKindSound) {
+			chunk.compressionType = kIndexSnd;
+			chunk.uncompressedLen = soundData(chunk, false).size();
+		} else {
+			chunk.compressionType = (_options.compression == kCompressionZlib) ? kIndexZlib : kIndexNull;
+			chunk.uncompressedLen = chunkData(chunk).size();
+		}
+		chunk.len = storedData(chunk).size();
+		chunk.offset = offset;
+		offset += chunk.len;
+	}
+
+	_abHeaderSize = afterburnerHeader().size();
+	_totalSize = _abHeaderSize + offset;
+}
+
+Generator::MemberKind Generator::memberKind(unsigned int memberIndex) const {
+	if (memberIndex < _options.scriptsPerCast)
+		return kMemberScript;
+	if (memberIndex < _options.scriptsPerCast + _options.bitmapsPerCast)
+		return kMemberBitmap;
+	return kMemberSound;
+}
+
+uint32_t Generator::chunkSeed(const GenChunk &chunk) const {
+	// Derive an independent stream per chunk so chunks can be regenerated in any order
+	std::seed_seq seq{ _options.seed, (uint32_t)chunk.id, (uint32_t)chunk.kind };
+	uint32_t res;
+	seq.generate(&res, &res + 1);
+	return res;
+}
+
+// chunk contents
+
+std::vector<uint8_t> Generator::chunkData(const GenChunk &chunk) const {
+	switch (chunk.kind) {
+	case kKindKeyTable:
+		return keyTableData();
+	case kKindConfig:
+		return configData();
+	case kKindCastList:
+		return castListData();
+	case kKindCast:
+		return castData(chunk);
+	case kKindScriptContext:
+		return scriptContextData(chunk);
+	case kKindScriptNames:
+		return scriptNamesData();
+	case kKindCastMember:
+		return castMemberData(chunk);
+	case kKindScript:
+		return scriptData(chunk);
+	case kKindBitmapData:
+		return bitmapData(chunk);
+	case kKindSound:
+		return soundData(chunk, false);
+	}
+	return {};
+}
+
+std::vector<uint8_t> Generator::keyTableData() const {
+	Director::KeyTableChunk keyTable(_dir.get());
+	for (const auto &cast : _casts) {
+		keyTable.entries.push_back({ cast.castChunkID, cast.listID, FOURCC('C', 'A', 'S', '*') });
+		keyTable.entries.push_back({ cast.lctxID, cast.listID, FOURCC('L', 'c', 't', 'x') });
+		for (size_t m = 0; m < cast.memberIDs.size(); m++) {
+			if (cast.dataIDs[m] < 0)
+				continue;
+
+			uint32_t fourCC = (memberKind(m) == kMemberSound) ? FOURCC('s', 'n', 'd', ' ') : FOURCC('B', 'I', 'T', 'D');
+			keyTable.entries.push_back({ cast.dataIDs[m], cast.memberIDs[m], fourCC });
+		}
+	}
+	keyTable.entrySize = 12;
+	keyTable.entrySize2 = 12;
+	keyTable.entryCount = keyTable.entries.size();
+	keyTable.usedCount = keyTable.entries.size();
+
+	std::vector<uint8_t> buf(keyTable.size());
+	Common::WriteStream stream(buf.data(), buf.size(), _options.endianness);
+	keyTable.write(stream);
+	return buf;
+}
+
+std::vector<uint8_t> Generator::configData() const {
+	static uint8_t remnants[32] = {};
+
+	Director::ConfigChunk config(_dir.get());
+	config.len = 68 + sizeof(remnants);
+	config.directorVersion = Director::rawVersion(_options.version);
+	config.fileVersion = config.directorVersion;
+	config.movieTop = 0;
+	config.movieLeft = 0;
+	config.movieBottom = 480;
+	config.movieRight = 640;
+	config.minMember = 1;
+	config.maxMember = _options.scriptsPerCast + _options.bitmapsPerCast + _options.soundsPerCast;
+	config.field9 = 0;
+	config.field10 = 0;
+	config.preD7field11 = 0;
+	config.D7stageColorG = 0xFF;
+	config.D7stageColorB = 0xFF;
+	config.commentFont = 0;
+	config.commentSize = 12;
+	config.commentStyle = 0;
+	config.preD7stageColor = 0;
+	config.D7stageColorIsRGB = 1;
+	config.D7stageColorR = 0xFF;
+	config.bitDepth = 32;
+	config.field17 = 0;
+	config.field18 = 0;
+	config.field19 = 0;
+	config.field21 = 0;
+	config.field22 = 0;
+	config.field23 = 0;
+	config.field24 = 0;
+	config.field25 = 0;
+	config.field26 = 0;
+	config.frameRate = 30;
+	config.platform = (_options.endianness == Common::kBigEndian) ? 1 : 2;
+	config.protection = 0;
+	config.field29 = 0;
+	config.remnants = Common::BufferView(remnants, sizeof(remnants));
+
+	std::vector<uint8_t> buf(config.size());
+	Common::WriteStream stream(buf.data(), buf.size(), _options.endianness);
+	config.write(stream);
+	return buf;
+}
+
+std::vector<uint8_t> Generator::castListData() const {
+	Director::CastListChunk castList(_dir.get());
+	castList.unk0 = 0;
+	castList.castCount = _casts.size();
+	castList.itemsPerCast = 4;
+	castList.unk1 = 0;
+	castList.entries.resize(_casts.size());
+	for (size_t c = 0; c < _casts.size(); c++) {
+		auto &entry = castList.entries[c];
+		entry.name = (c == 0) ? "Internal" : "Cast " + std::to_string(c + 1);
+		entry.preloadSettings = 0;
+		entry.minMember = 1;
+		entry.maxMember = _casts[c].memberIDs.size();
+		entry.id = _casts[c].listID;
+	}
+	castList.offsetTableLen = castList.castCount * castList.itemsPerCast + 1;
+	castList.offsetTable.resize(castList.offsetTableLen);
+	castList.items.resize(castList.offsetTableLen);
+
+	std::vector<uint8_t> buf(castList.size());
+	Common::WriteStream stream(buf.data(), buf.size(), Common::kBigEndian);
+	castList.write(stream);
+	return buf;
+}
+
+std::vector<uint8_t> Generator::castData(const GenChunk &chunk) const {
+	Director::CastChunk cast(_dir.get());
+	cast.memberIDs = _casts[chunk.castIndex].memberIDs;
+
+	std::vector<uint8_t> buf(cast.size());
+	Common::WriteStream stream(buf.data(), buf.size(), Common::kBigEndian);
+	cast.write(stream);
+	return buf;
+}
+
+std::vector<uint8_t> Generator::scriptContextData(const GenChunk &chunk) const {
+	const GenCast &cast = _casts[chunk.castIndex];
+
+	std::vector<uint8_t> buf(kScriptContextHeaderSize + 12 * cast.scriptIDs.size());
+	Common::WriteStream stream(buf.data(), buf.size(), Common::kBigEndian);
+	stream.writeInt32(0); // unknown0
+	stream.writeInt32(0); // unknown1
+	stream.writeUint32(cast.scriptIDs.size()); // entryCount
+	stream.writeUint32(cast.scriptIDs.size()); // entryCount2
+	stream.writeUint16(kScriptContextHeaderSize); // entriesOffset
+	stream.writeInt16(0); // unknown2
+	stream.writeInt32(0); // unknown3
+	stream.writeInt32(0); // unknown4
+	stream.writeInt32(0); // unknown5
+	stream.writeInt32(cast.lnamID);
+	stream.writeUint16(cast.scriptIDs.size()); // validCount
+	stream.writeUint16(0); // flags
+	stream.writeInt16(-1); // freePointer
+	for (auto sectionID : cast.scriptIDs) {
+		stream.writeInt32(0); // unknown0
+		stream.writeInt32(sectionID);
+		stream.writeUint16(4); // unknown1
+		stream.writeUint16(0); // unknown2
+	}
+	return buf;
+}
+
+std::vector<uint8_t> Generator::scriptNamesData() const {
+	size_t namesLen = 0;
+	for (const auto &name : _names) {
+		namesLen += 1 + name.size();
+	}
+
+	std::vector<uint8_t> buf(kScriptNamesHeaderSize + namesLen);
+	Common::WriteStream stream(buf.data(), buf.size(), Common::kBigEndian);
+	stream.writeInt32(0); // unknown0
+	stream.writeInt32(0); // unknown1
+	stream.writeUint32(buf.size()); // len1
+	stream.writeUint32(buf.size()); // len2
+	stream.writeUint16(kScriptNamesHeaderSize); // namesOffset
+	stream.writeUint16(_names.size());
+	for (const auto &name : _names) {
+		stream.writePascalString(name);
+	}
+	return buf;
+}
+
+std::vector<uint8_t> Generator::castMemberData(const GenChunk &chunk) const {
+	MemberKind kind = memberKind(chunk.index);
+
+	Director::CastMemberChunk member(_dir.get());
+	member.hasFlags1 = false;
+	member.flags1 = 0;
+	member.info = std::make_shared<Director::CastInfoChunk>(_dir.get());
+	member.info->unk1 = 0;
+	member.info->unk2 = 0;
+	member.info->flags = 0;
+	member.info->scriptId = 0;
+	member.info->offsetTableLen = 2; // scriptSrcText, name
+	member.info->offsetTable.resize(member.info->offsetTableLen);
+	member.info->items.resize(member.info->offsetTableLen);
+
+	std::vector<uint8_t> specificData;
+	switch (kind) {
+	case kMemberScript:
+		{
+			static const Director::ScriptType scriptTypes[] = { Director::kMovieScript, Director::kScoreScript, Director::kParentScript };
+			member.type = Director::kScriptMember;
+			member.info->scriptId = chunk.index + 1; // scripts come first, in context order
+			member.info->name = "script" + std::to_string(chunk.index + 1);
+			uint16_t scriptType = scriptTypes[chunk.index % 3];
+			specificData = { (uint8_t)(scriptType >> 8), (uint8_t)scriptType };
+		}
+		break;
+	case kMemberBitmap:
+		member.type = Director::kBitmapMember;
+		member.info->name = "bitmap" + std::to_string(chunk.index + 1);
+		specificData.resize(kBitmapSpecificDataSize);
+		break;
+	case kMemberSound:
+		member.type = Director::kSoundMember;
+		member.info->name = "sound" + std::to_string(chunk.index + 1);
+		break;
+	}
+	member.specificData = Common::BufferView(specificData.data(), specificData.size());
+
+	std::vector<uint8_t> buf(member.size());
+	Common::WriteStream stream(buf.data(), buf.size(), Common::kBigEndian);
+	member.write(stream);
+	return buf;
+}
+
+std::vector<uint8_t> Generator::scriptData(const GenChunk &chunk) const {
+	std::mt19937 rng(chunkSeed(chunk));
+	auto randomInt = [&](uint32_t n) { return (n > 0) ? rng() % n : 0; };
+
+	bool isParent = (chunk.index % 3 == 2);
+	int mult = (_options.version >= 850) ? 1 : 8;
+	size_t localBase = _options.handlersPerScript;
+	size_t argBase = localBase + kLocalCount;
+	size_t globalBase = argBase + kArgumentCount;
+	size_t propBase = globalBase + kGlobalCount;
+	size_t callBase = propBase + kPropertyCount;
+
+	// Literals
+	struct Literal {
+		LiteralType type;
+		uint32_t offset;
+		std::string str;
+		double f;
+	};
+	std::vector<Literal> literals(_options.literalsPerScript);
+	size_t literalsDataLen = 0;
+	for (auto &literal : literals) {
+		uint32_t roll = randomInt(100);
+		if (roll < _options.stringLiteralPercent) {
+			literal.type = kLiteralString;
+			literal.str = kWords[randomInt(countOf(kWords))];
+			unsigned int extraWords = randomInt(4);
+			for (unsigned int i = 0; i < extraWords; i++) {
+				literal.str += " ";
+				literal.str += kWords[randomInt(countOf(kWords))];
+			}
+			literal.offset = literalsDataLen;
+			literalsDataLen += 4 + literal.str.size() + 1;
+		} else if (roll < _options.stringLiteralPercent + _options.floatLiteralPercent) {
+			literal.type = kLiteralFloat;
+			literal.f = randomInt(100000) / 100.0;
+			literal.offset = literalsDataLen;
+			literalsDataLen += 4 + 8;
+		} else {
+			literal.type = kLiteralInt;
+			literal.offset = 1000 + randomInt(1000000); // ints are stored in the record
+		}
+	}
+
+	// Handler bytecode, built from statement templates that decompile cleanly
+	std::vector<std::vector<uint8_t>> code(_options.handlersPerScript);
+	for (auto &handlerCode : code) {
+		auto local = [&]() { return (int32_t)(randomInt(kLocalCount) * mult); };
+		auto value = [&](std::vector<uint8_t> &out) {
+			if (!literals.empty() && randomInt(2)) {
+				writeOp(out, kOpPushCons, randomInt(literals.size()) * mult);
+			} else {
+				writeOp(out, kOpPushInt8, randomInt(200));
+			}
+		};
+
+		for (unsigned int s = 0; s < _options.statementsPerHandler; s++) {
+			switch (randomInt(isParent ? 9 : 8)) {
+			case 0: // local = value
+			case 1:
+				value(handlerCode);
+				writeOp(handlerCode, kOpSetLocal, local());
+				break;
+			case 2: // local = local + value
+				{
+					int32_t dest = local();
+					writeOp(handlerCode, kOpGetLocal, local());
+					writeOp(handlerCode, kOpGetParam, 1 * mult);
+					writeOp(handlerCode, kOpAdd);
+					writeOp(handlerCode, kOpSetLocal, dest);
+				}
+				break;
+			case 3: // call(value)
+				value(handlerCode);
+				writeOp(handlerCode, kOpPushArgListNoRet, 1);
+				writeOp(handlerCode, kOpExtCall, callBase + randomInt(kCallCount));
+				break;
+			case 4: // local = random(1, n)
+				writeOp(handlerCode, kOpPushInt8, 1);
+				writeOp(handlerCode, kOpPushInt8, 2 + randomInt(100));
+				writeOp(handlerCode, kOpPushArgList, 2);
+				writeOp(handlerCode, kOpExtCall, callBase + kRandomCall);
+				writeOp(handlerCode, kOpSetLocal, local());
+				break;
+			case 5: // global = local * 2
+				writeOp(handlerCode, kOpGetLocal, local());
+				writeOp(handlerCode, kOpPushInt8, 2);
+				writeOp(handlerCode, kOpMul);
+				writeOp(handlerCode, kOpSetGlobal, globalBase + randomInt(kGlobalCount));
+				break;
+			case 6: // if local > n then local = local - 1
+				{
+					int32_t var = local();
+					writeOp(handlerCode, kOpGetLocal, var);
+					writeOp(handlerCode, kOpPushInt8, randomInt(100));
+					writeOp(handlerCode, kOpGt);
+					std::vector<uint8_t> body;
+					writeOp(body, kOpGetLocal, var);
+					writeOp(body, kOpPushInt8, 1);
+					writeOp(body, kOpSub);
+					writeOp(body, kOpSetLocal, var);
+					writeJump(handlerCode, kOpJmpIfZ, body);
+				}
+				break;
+			case 7: // repeat while local < n: local = local + 1
+				{
+					int32_t var = local();
+					size_t loopStart = handlerCode.size();
+					writeOp(handlerCode, kOpGetLocal, var);
+					writeOp(handlerCode, kOpPushInt8, 1 + randomInt(100));
+					writeOp(handlerCode, kOpLt);
+					std::vector<uint8_t> body;
+					writeOp(body, kOpGetLocal, var);
+					writeOp(body, kOpPushInt8, 1);
+					writeOp(body, kOpAdd);
+					writeOp(body, kOpSetLocal, var);
+					// endrepeat always takes a two byte operand so the body size is known
+					size_t jmpIfZSize = (2 + body.size() + 3 > UINT8_MAX) ? 3 : 2;
+					size_t endRepeatPos = handlerCode.size() + jmpIfZSize + body.size();
+					uint16_t back = endRepeatPos - loopStart;
+					body.push_back(kOpEndRepeat + 0x40);
+					body.push_back((uint8_t)(back >> 8));
+					body.push_back((uint8_t)back);
+					writeJump(handlerCode, kOpJmpIfZ, body);
+				}
+				break;
+			case 8: // property = local
+				writeOp(handlerCode, kOpGetLocal, local());
+				writeOp(handlerCode, kOpSetProp, propBase + randomInt(kPropertyCount));
+				break;
+			}
+		}
+		writeOp(handlerCode, kOpRet);
+	}
+
+	// Layout
+	size_t handlerRecordSize = (_options.version >= 850) ? 46 : 42;
+	size_t propertiesCount = isParent ? kPropertyCount : 0;
+	size_t propertiesOffset = kScriptHeaderSize;
+	size_t globalsOffset = propertiesOffset + 2 * propertiesCount;
+	size_t handlersOffset = globalsOffset + 2 * kGlobalCount;
+	size_t pos = handlersOffset + handlerRecordSize * code.size();
+
+	std::vector<size_t> compiledOffsets;
+	for (const auto &handlerCode : code) {
+		compiledOffsets.push_back(pos);
+		pos += handlerCode.size();
+		pos += 2 * kArgumentCount; // arguments
+		pos += 2 * kLocalCount; // locals
+	}
+	size_t literalsOffset = pos;
+	size_t literalRecordSize = 8;
+	size_t literalsDataOffset = literalsOffset + literalRecordSize * literals.size();
+	size_t totalLength = literalsDataOffset + literalsDataLen;
+
+	std::vector<uint8_t> buf(totalLength);
+	Common::WriteStream stream(buf.data(), buf.size(), Common::kBigEndian);
+
+	/*  0 */ stream.writeInt32(0);
+	/*  4 */ stream.writeInt32(0);
+	/*  8 */ stream.writeUint32(totalLength);
+	/* 12 */ stream.writeUint32(totalLength);
+	/* 16 */ stream.writeUint16(kScriptHeaderSize);
+	/* 18 */ stream.writeUint16(chunk.index + 1); // scriptNumber
+	/* 20 */ stream.writeInt16(0);
+	/* 22 */ stream.writeInt16(-1); // parentNumber
+	stream.seek(38);
+	/* 38 */ stream.writeUint32(0); // scriptFlags
+	/* 42 */ stream.writeInt16(0);
+	/* 44 */ stream.writeInt32(chunk.index + 1); // castID
+	/* 48 */ stream.writeInt16(-1); // factoryNameID
+	/* 50 */ stream.writeUint16(0); // handlerVectorsCount
+	/* 52 */ stream.writeUint32(0); // handlerVectorsOffset
+	/* 56 */ stream.writeUint32(0); // handlerVectorsSize
+	/* 60 */ stream.writeUint16(propertiesCount);
+	/* 62 */ stream.writeUint32(propertiesOffset);
+	/* 66 */ stream.writeUint16(kGlobalCount);
+	/* 68 */ stream.writeUint32(globalsOffset);
+	/* 72 */ stream.writeUint16(code.size());
+	/* 74 */ stream.writeUint32(handlersOffset);
+	/* 78 */ stream.writeUint16(literals.size());
+	/* 80 */ stream.writeUint32(literalsOffset);
+	/* 84 */ stream.writeUint32(literalsDataLen);
+	/* 88 */ stream.writeUint32(literalsDataOffset);
+
+	for (size_t i = 0; i < propertiesCount; i++) {
+		stream.writeInt16(propBase + i);
+	}
+	for (size_t i = 0; i < kGlobalCount; i++) {
+		stream.writeInt16(globalBase + i);
+	}
+
+	for (size_t h = 0; h < code.size(); h++) {
+		size_t argumentOffset = compiledOffsets[h] + code[h].size();
+		size_t localsOffset = argumentOffset + 2 * kArgumentCount;
+		stream.writeInt16(h); // nameID
+		stream.writeUint16(0); // vectorPos
+		stream.writeUint32(code[h].size());
+		stream.writeUint32(compiledOffsets[h]);
+		stream.writeUint16(kArgumentCount);
+		stream.writeUint32(argumentOffset);
+		stream.writeUint16(kLocalCount);
+		stream.writeUint32(localsOffset);
+		stream.writeUint16(0); // globalsCount
+		stream.writeUint32(0); // globalsOffset
+		stream.writeUint32(0); // unknown1
+		stream.writeUint16(0); // unknown2
+		stream.writeUint16(0); // lineCount
+		stream.writeUint32(0); // lineOffset
+		if (_options.version >= 850)
+			stream.writeUint32(8); // stackHeight
+	}
+
+	for (size_t h = 0; h < code.size(); h++) {
+		stream.writeBytes(code[h].data(), code[h].size());
+		for (size_t i = 0; i < kArgumentCount; i++) {
+			stream.writeInt16(argBase + i);
+		}
+		for (size_t i = 0; i < kLocalCount; i++) {
+			stream.writeInt16(localBase + i);
+		}
+	}
+
+	for (const auto &literal : literals) {
+		stream.writeUint32(literal.type);
+		stream.writeUint32(literal.offset);
+	}
+	for (const auto &literal : literals) {
+		if (literal.type == kLiteralString) {
+			stream.writeUint32(literal.str.size() + 1);
+			stream.writeString(literal.str);
+			stream.writeUint8(0);
+		} else if (literal.type == kLiteralFloat) {
+			stream.writeUint32(8);
+			stream.writeDouble(literal.f);
+		}
+	}
+
+	return buf;
+}
+
+std::vector<uint8_t> Generator::bitmapData(const GenChunk &chunk) const {
+	// Alternate runs and noise so the data compresses about as well as real artwork
+	std::mt19937 rng(chunkSeed(chunk));
+	std::vector<uint8_t> buf(_options.bitmapSize);
+	size_t pos = 0;
+	while (pos < buf.size()) {
+		size_t len = std::min<size_t>(1 + rng() % 64, buf.size() - pos);
+		if (rng() % 2) {
+			uint8_t val = rng();
+			std::fill(buf.begin() + pos, buf.begin() + pos + len, val);
+		} else {
+			for (size_t i = 0; i < len; i++) {
+				buf[pos + i] = rng();
+			}
+		}
+		pos += len;
+	}
+	return buf;
+}
+
+// Writes a mono MPEG-1 layer III frame whose granules each hold random
+// spectral lines of magnitude 0 or 1, coded with Huffman table 1, so the
+// frame decodes to quiet noise. The main data starts in the frame itself.
+static void writeNoiseFrame(Common::WriteStream &stream, std::mt19937 &rng) {
+	static const size_t kSideInfoSize = 17;
+	static const unsigned int kBigValues = 32; // pairs of spectral lines per granule
+	static const unsigned int kGlobalGain = 170;
+
+	uint8_t frame[kMP3FrameSize] = {};
+	size_t bitPos = 0;
+	auto writeBits = [&frame, &bitPos](uint32_t value, unsigned int count) {
+		for (unsigned int i = count; i-- > 0; bitPos++) {
+			if (value & (1u << i))
+				frame[bitPos / 8] |= 0x80 >> (bitPos % 8);
+		}
+	};
+
+	// Main data: each pair's codeword, then a sign bit per nonzero value
+	bitPos = (sizeof(kMP3FrameHeader) + kSideInfoSize) * 8;
+	uint32_t granuleBits[2];
+	for (uint32_t &bits : granuleBits) {
+		size_t start = bitPos;
+		for (unsigned int i = 0; i < kBigValues; i++) {
+			unsigned int x = (rng() % 4 == 0);
+			unsigned int y = (rng() % 4 == 0);
+			static const uint8_t kTable1Codes[2][2] = { { 0x1, 0x1 }, { 0x1, 0x0 } };
+			static const uint8_t kTable1Lengths[2][2] = { { 1, 3 }, { 2, 3 } };
+			writeBits(kTable1Codes[x][y], kTable1Lengths[x][y]);
+			if (x)
+				writeBits(rng() % 2, 1);
+			if (y)
+				writeBits(rng() % 2, 1);
+		}
+		bits = bitPos - start;
+	}
+
+	bitPos = 0;
+	for (uint8_t byte : kMP3FrameHeader) {
+		writeBits(byte, 8);
+	}
+	writeBits(0, 9); // main_data_begin
+	writeBits(0, 5); // private_bits
+	writeBits(0, 4); // scfsi
+	for (uint32_t bits : granuleBits) {
+		writeBits(bits, 12); // part2_3_length, no scale factors
+		writeBits(kBigValues, 9); // big_values
+		writeBits(kGlobalGain, 8); // global_gain
+		writeBits(0, 4); // scalefac_compress
+		writeBits(0, 1); // window_switching_flag
+		for (int region = 0; region < 3; region++) {
+			writeBits(1, 5); // table_select
+		}
+		writeBits(0, 4); // region0_count
+		writeBits(0, 3); // region1_count
+		writeBits(0, 3); // preflag, scalefac_scale, count1table_select
+	}
+
+	stream.writeBytes(frame, sizeof(frame));
+}
+
+std::vector<uint8_t> Generator::soundData(const GenChunk &chunk, bool compressed) const {
+	uint32_t numSamples = _options.soundFrames * kMP3FrameSamples - _options.soundSkipSamples;
+	size_t headerSize = 2 + 2 + 6 + 2 + 8 + 22 + 42;
+	size_t bodySize = compressed
+		? 4 + _options.soundFrames * kMP3FrameSize // skipSamples, MP3 frames
+		: 2 * numSamples; // 16-bit mono PCM
+
+	std::vector<uint8_t> buf(headerSize + bodySize);
+	Common::WriteStream stream(buf.data(), buf.size(), Common::kBigEndian);
+
+	// 'snd ' format 1 resource with one bufferCmd
+	stream.writeUint16(1); // format
+	stream.writeUint16(1); // dataFormatCount
+	stream.writeUint16(5); // sampledSynth
+	stream.writeUint32(0x80); // initMono
+	stream.writeUint16(1); // soundCommandCount
+	stream.writeUint16(0x8051); // bufferCmd
+	stream.writeUint16(0); // param1
+	stream.writeUint32(20); // param2: offset of the sound header
+
+	// Extended sound header
+	stream.writeUint32(0); // samplePtr
+	stream.writeUint32(1); // numChannels
+	stream.writeUint16(kSoundSampleRate);
+	stream.writeUint16(0); // sampleRateFrac
+	stream.writeUint32(0); // loopStart
+	stream.writeUint32(0); // loopEnd
+	stream.writeUint8(0xFF); // extended encode
+	stream.writeUint8(60); // baseFrequency
+	stream.writeUint32(numSamples);
+	static const uint8_t AIFFSampleRate[10] = { 0x40, 0x0E, 0xAC, 0x44, 0, 0, 0, 0, 0, 0 }; // 44100.0
+	stream.writeBytes(AIFFSampleRate, sizeof(AIFFSampleRate));
+	stream.writeUint32(0); // markerChunk
+	stream.writeUint32(0); // instrumentChunks
+	stream.writeUint32(0); // AESRecording
+	stream.writeUint16(16); // sampleSize
+	stream.writeUint16(0); // futureUse1
+	stream.writeUint32(0); // futureUse2
+	stream.writeUint32(0); // futureUse3
+	stream.writeUint32(0); // futureUse4
+
+	if (compressed) {
+		stream.writeUint32(_options.soundSkipSamples);
+		std::mt19937 rng(chunkSeed(chunk));
+		for (unsigned int i = 0; i < _options.soundFrames; i++) {
+			if (_options.soundNoise) {
+				writeNoiseFrame(stream, rng);
+			} else {
+				// Digital silence: a header followed by zeroed side info and main data
+				stream.writeBytes(kMP3FrameHeader, sizeof(kMP3FrameHeader));
+				stream.skip(kMP3FrameSize - sizeof(kMP3FrameHeader));
+			}
+		}
+	}
+	return buf;
+}
+
+std::vector<uint8_t> Generator::memoryMapData() const {
+	Director::MemoryMapChunk mmap(_dir.get());
+	mmap.headerLength = kMemoryMapHeaderSize;
+	mmap.entryLength = kMemoryMapEntrySize;
+	mmap.chunkCountMax = _chunks.size() + 3;
+	mmap.chunkCountUsed = _chunks.size() + 3;
+	mmap.junkHead = -1;
+	mmap.junkHead2 = -1;
+	mmap.freeHead = -1;
+
+	size_t mmapLen = mmap.size();
+	mmap.mapArray.push_back({ FOURCC('R', 'I', 'F', 'X'), (uint32_t)(_totalSize - kChunkHeaderSize), 0, 1, 0, 0 });
+	mmap.mapArray.push_back({ FOURCC('i', 'm', 'a', 'p'), kInitialMapSize, kRIFXHeaderSize, 1, 0, 0 });
+	mmap.mapArray.push_back({
+		FOURCC('m', 'm', 'a', 'p'), (uint32_t)mmapLen, (int32_t)(kRIFXHeaderSize + kChunkHeaderSize + kInitialMapSize), 0, 0, 0
+	});
+	for (const auto &chunk : _chunks) {
+		mmap.mapArray.push_back({ chunk.fourCC, (uint32_t)chunk.len, (int32_t)chunk.offset, 0, 0, 0 });
+	}
+
+	std::vector<uint8_t> buf(mmapLen);
+	Common::WriteStream stream(buf.data(), buf.size(), _options.endianness);
+	mmap.write(stream);
+	return buf;
+}
+
+std::vector<uint8_t> Generator::storedData(const GenChunk &chunk) const {
+	switch (chunk.compressionType) {
+	case kIndexZlib:
+		return compressZlib(chunkData(chunk), _options.compressionLevel);
+	case kIndexSnd:
+		return soundData(chunk, true);
+	default:
+		return chunkData(chunk);
+	}
+}
+
+// writing
+
+std::vector<uint8_t> Generator::afterburnerHeader() const {
+	// Fver
+	std::string versionString = Director::versionNumber(_options.version, "");
+	std::vector<uint8_t> fver(
+		Common::WriteStream::varIntSize(0x501)
+		+ Common::WriteStream::varIntSize(1)
+		+ Common::WriteStream::varIntSize(Director::rawVersion(_options.version))
+		+ 1 + versionString.size()
+	);
+	Common::WriteStream fverStream(fver.data(), fver.size(), _options.endianness);
+	fverStream.writeVarInt(0x501); // fverVersion
+	fverStream.writeVarInt(1); // imapVersion
+	fverStream.writeVarInt(Director::rawVersion(_options.version));
+	fverStream.writePascalString(versionString);
+
+	// Fcdr
+	const MoaID compressionIDs[] = { ZLIB_COMPRESSION_GUID, SND_COMPRESSION_GUID, NULL_COMPRESSION_GUID };
+	const std::string compressionDescs[] = { "zlib", "snd", "none" };
+	size_t fcdrLen = 2 + 16 * countOf(compressionIDs);
+	for (const auto &desc : compressionDescs) {
+		fcdrLen += desc.size() + 1;
+	}
+	std::vector<uint8_t> fcdr(fcdrLen);
+	Common::WriteStream fcdrStream(fcdr.data(), fcdr.size(), _options.endianness);
+	fcdrStream.writeUint16(countOf(compressionIDs));
+	for (const auto &compressionID : compressionIDs) {
+		compressionID.write(fcdrStream);
+	}
+	for (const auto &desc : compressionDescs) {
+		fcdrStream.writeString(desc);
+		fcdrStream.writeUint8(0);
+	}
+	std::vector<uint8_t> fcdrCompressed = compressZlib(fcdr, _options.compressionLevel);
+
+	// ABMP
+	auto entrySize = [](uint32_t id, uint32_t offset, uint32_t len, uint32_t uncompressedLen, uint32_t compressionType) {
+		return Common::WriteStream::varIntSize(id)
+			+ Common::WriteStream::varIntSize(offset)
+			+ Common::WriteStream::varIntSize(len)
+			+ Common::WriteStream::varIntSize(uncompressedLen)
+			+ Common::WriteStream::varIntSize(compressionType)
+			+ 4;
+	};
+	size_t abmpLen = 2 + Common::WriteStream::varIntSize(_chunks.size() + 1);
+	abmpLen += entrySize(2, 0, _ilsData.size(), _ilsLen, kIndexZlib);
+	for (const auto &chunk : _chunks) {
+		abmpLen += entrySize(chunk.id, chunk.offset, chunk.len, chunk.uncompressedLen, chunk.compressionType);
+	}
+	std::vector<uint8_t> abmp(abmpLen);
+	Common::WriteStream abmpStream(abmp.data(), abmp.size(), _options.endianness);
+	abmpStream.writeVarInt(0); // unk1
+	abmpStream.writeVarInt(0); // unk2
+	abmpStream.writeVarInt(_chunks.size() + 1);
+	abmpStream.writeVarInt(2); // ILS
+	abmpStream.writeVarInt(0);
+	abmpStream.writeVarInt(_ilsData.size());
+	abmpStream.writeVarInt(_ilsLen);
+	abmpStream.writeVarInt(kIndexZlib);
+	abmpStream.writeUint32(FOURCC('I', 'L', 'S', ' '));
+	for (const auto &chunk : _chunks) {
+		abmpStream.writeVarInt(chunk.id);
+		abmpStream.writeVarInt(chunk.offset);
+		abmpStream.writeVarInt(chunk.len);
+		abmpStream.writeVarInt(chunk.uncompressedLen);
+		abmpStream.writeVarInt(chunk.compressionType);
+		abmpStream.writeUint32(chunk.fourCC);
+	}
+	std::vector<uint8_t> abmpCompressed = compressZlib(abmp, _options.compressionLevel);
+	size_t abmpBodyLen = Common::WriteStream::varIntSize(kIndexZlib)
+		+ Common::WriteStream::varIntSize(abmp.size())
+		+ abmpCompressed.size();
+
+	// Assemble
+	size_t headerLen = kRIFXHeaderSize;
+	headerLen += 4 + Common::WriteStream::varIntSize(fver.size()) + fver.size();
+	headerLen += 4 + Common::WriteStream::varIntSize(fcdrCompressed.size()) + fcdrCompressed.size();
+	headerLen += 4 + Common::WriteStream::varIntSize(abmpBodyLen) + abmpBodyLen;
+	headerLen += 4 + Common::WriteStream::varIntSize(0); // FGEI
+
+	std::vector<uint8_t> buf(headerLen);
+	Common::WriteStream stream(buf.data(), buf.size(), _options.endianness);
+	stream.writeUint32(FOURCC('R', 'I', 'F', 'X'));
+	stream.writeUint32((_totalSize > kChunkHeaderSize) ? _totalSize - kChunkHeaderSize : 0);
+	stream.writeUint32(_options.isCast ? FOURCC('F', 'G', 'D', 'C') : FOURCC('F', 'G', 'D', 'M'));
+
+	stream.writeUint32(FOURCC('F', 'v', 'e', 'r'));
+	stream.writeVarInt(fver.size());
+	stream.writeBytes(fver.data(), fver.size());
+
+	stream.writeUint32(FOURCC('F', 'c', 'd', 'r'));
+	stream.writeVarInt(fcdrCompressed.size());
+	stream.writeBytes(fcdrCompressed.data(), fcdrCompressed.size());
+
+	stream.writeUint32(FOURCC('A', 'B', 'M', 'P'));
+	stream.writeVarInt(abmpBodyLen);
+	stream.writeVarInt(kIndexZlib);
+	stream.writeVarInt(abmp.size());
+	stream.writeBytes(abmpCompressed.data(), abmpCompressed.size());
+
+	stream.writeUint32(FOURCC('F', 'G', 'E', 'I'));
+	stream.writeVarInt(0); // unk1
+	return buf;
+}
+
+static void writeBuf(std::ostream &out, const std::vector<uint8_t> &buf) {
+	out.write(reinterpret_cast<const char *>(buf.data()), buf.size());
+}
+
+static std::vector<uint8_t> chunkHeader(uint32_t fourCC, uint32_t len, Common::Endianness endianness) {
+	std::vector<uint8_t> buf(kChunkHeaderSize);
+	Common::WriteStream stream(buf.data(), buf.size(), endianness);
+	stream.writeUint32(fourCC);
+	stream.writeUint32(len);
+	return buf;
+}
+
+void Generator::writeRIFX(std::ostream &out) const {
+	std::vector<uint8_t> header = chunkHeader(FOURCC('R', 'I', 'F', 'X'), _totalSize - kChunkHeaderSize, _options.endianness);
+	header.resize(kRIFXHeaderSize);
+	Common::WriteStream headerStream(header.data(), header.size(), _options.endianness, kChunkHeaderSize);
+	headerStream.writeUint32(_options.isCast ? FOURCC('M', 'C', '9', '5') : FOURCC('M', 'V', '9', '3'));
+	writeBuf(out, header);
+
+	Director::InitialMapChunk imap(_dir.get());
+	imap.version = 1;
+	imap.mmapOffset = kRIFXHeaderSize + kChunkHeaderSize + kInitialMapSize;
+	imap.directorVersion = Director::rawVersion(_options.version);
+	imap.unused1 = 0;
+	imap.unused2 = 0;
+	imap.unused3 = 0;
+	std::vector<uint8_t> imapBuf(imap.size());
+	Common::WriteStream imapStream(imapBuf.data(), imapBuf.size(), _options.endianness);
+	imap.write(imapStream);
+	writeBuf(out, chunkHeader(FOURCC('i', 'm', 'a', 'p'), imapBuf.size(), _options.endianness));
+	writeBuf(out, imapBuf);
+
+	std::vector<uint8_t> mmapBuf = memoryMapData();
+	writeBuf(out, chunkHeader(FOURCC('m', 'm', 'a', 'p'), mmapBuf.size(), _options.endianness));
+	writeBuf(out, mmapBuf);
+
+	for (const auto &chunk : _chunks) {
+		writeBuf(out, chunkHeader(chunk.fourCC, chunk.len, _options.endianness));
+		writeBuf(out, chunkData(chunk));
+	}
+}
+
+void Generator::writeAfterburner(std::ostream &out) const {
+	writeBuf(out, afterburnerHeader());
+	writeBuf(out, _ilsData);
+	for (const auto &chunk : _chunks) {
+		if (!chunk.inILS) {
+			writeBuf(out, storedData(chunk));
+		}
+	}
+}
+
+void Generator::write(std::ostream &out) const {
+	if (_options.container == kContainerRIFX) {
+		writeRIFX(out);
+	} else {
+		writeAfterburner(out);
+	}
+}
+
+std::vector<uint8_t> Generator::build() const {
+	std::ostringstream out;
+	write(out);
+	std::string str = out.str();
+	return std::vector<uint8_t>(str.begin(), str.end());
+}
+
+} // namespace Gen
@@ -0,0 +1,168 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef GEN_GENERATOR_H
+#define GEN_GENERATOR_H
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "common/stream.h"
+
+namespace Director {
+class DirectorFile;
+}
+
+namespace Gen {
+
+enum Container {
+	kContainerRIFX,
+	kContainerAfterburner
+};
+
+enum Compression {
+	kCompressionNone,
+	kCompressionZlib
+};
+
+struct GeneratorOptions {
+	Container container = kContainerRIFX;
+	Common::Endianness endianness = Common::kBigEndian;
+	bool isCast = false;
+	unsigned int version = 850; // human version, 500 and up
+
+	// Compression for chunks outside the ILS (Afterburner only)
+	Compression compression = kCompressionZlib;
+	int compressionLevel = 6;
+
+	uint32_t seed = 1;
+
+	unsigned int castCount = 1;
+	unsigned int scriptsPerCast = 8;
+	unsigned int handlersPerScript = 4;
+	unsigned int statementsPerHandler = 16;
+
+	// Literal mix, as percentages of each script's literals
+	unsigned int literalsPerScript = 8;
+	unsigned int stringLiteralPercent = 50;
+	unsigned int floatLiteralPercent = 25;
+
+	// Filler members, each backed by its own data chunk
+	unsigned int bitmapsPerCast = 0;
+	size_t bitmapSize = 4096;
+	unsigned int soundsPerCast = 0;
+	unsigned int soundFrames = 38; // MPEG-1 layer III frames, about one second
+	unsigned int soundSkipSamples = 576; // encoder delay the decoder discards
+	bool soundNoise = false; // MP3 frames decode to noise instead of digital silence
+};
+
+/**
+ * Generator produces synthetic but structurally valid Director movies
+ * for benchmarking and fuzzing. The same options and seed always produce
+ * the same bytes.
+ *
+ * Chunks are laid out in a planning pass that records their sizes, then
+ * regenerated one at a time while writing, so only the largest chunk has
+ * to fit in memory.
+ */
+
+class Generator {
+private:
+	enum ChunkKind {
+		kKindKeyTable,
+		kKindConfig,
+		kKindCastList,
+		kKindCast,
+		kKindScriptContext,
+		kKindScriptNames,
+		kKindCastMember,
+		kKindScript,
+		kKindBitmapData,
+		kKindSound
+	};
+
+	enum MemberKind {
+		kMemberScript,
+		kMemberBitmap,
+		kMemberSound
+	};
+
+	struct GenChunk {
+		int32_t id;
+		uint32_t fourCC;
+		ChunkKind kind;
+		unsigned int castIndex;
+		unsigned int index; // member or script index within the cast
+		bool inILS;
+		uint32_t compressionType; // index into the Fcdr table
+		size_t len; // stored length
+		size_t uncompressedLen;
+		size_t offset; // RIFX: file offset, Afterburner: offset from the ILS body
+	};
+
+	struct GenCast {
+		int32_t castChunkID;
+		int32_t lctxID;
+		int32_t lnamID;
+		int32_t listID; // ID in the cast list and key table
+		std::vector<int32_t> memberIDs;
+		std::vector<int32_t> scriptIDs;
+		std::vector<int32_t> dataIDs; // BITD/snd chunk per member, or -1
+	};
+
+	GeneratorOptions _options;
+	std::unique_ptr<Director::DirectorFile> _dir;
+	std::vector<GenChunk> _chunks;
+	std::vector<GenCast> _casts;
+	std::vector<std::string> _names;
+	size_t _totalSize;
+
+	// Afterburner layout
+	std::vector<uint8_t> _ilsData;
+	size_t _ilsLen;
+	size_t _abHeaderSize;
+
+	void plan();
+	void planRIFX();
+	void planAfterburner();
+	int32_t addChunk(uint32_t fourCC, ChunkKind kind, unsigned int castIndex, unsigned int index, bool inILS);
+
+	MemberKind memberKind(unsigned int memberIndex) const;
+	uint32_t chunkSeed(const GenChunk &chunk) const;
+
+	std::vector<uint8_t> chunkData(const GenChunk &chunk) const;
+	std::vector<uint8_t> keyTableData() const;
+	std::vector<uint8_t> configData() const;
+	std::vector<uint8_t> castListData() const;
+	std::vector<uint8_t> castData(const GenChunk &chunk) const;
+	std::vector<uint8_t> scriptContextData(const GenChunk &chunk) const;
+	std::vector<uint8_t> scriptNamesData() const;
+	std::vector<uint8_t> castMemberData(const GenChunk &chunk) const;
+	std::vector<uint8_t> scriptData(const GenChunk &chunk) const;
+	std::vector<uint8_t> bitmapData(const GenChunk &chunk) const;
+	std::vector<uint8_t> soundData(const GenChunk &chunk, bool compressed) const;
+	std::vector<uint8_t> memoryMapData() const;
+	std::vector<uint8_t> storedData(const GenChunk &chunk) const;
+
+	std::vector<uint8_t> afterburnerHeader() const;
+	void writeRIFX(std::ostream &out) const;
+	void writeAfterburner(std::ostream &out) const;
+
+public:
+	Generator(const GeneratorOptions &options);
+	~Generator();
+
+	size_t size() const { return _totalSize; }
+	void write(std::ostream &out) const;
+	std::vector<uint8_t> build() const;
+};
+
+} // namespace Gen
+
+#endif // GEN_GENERATOR_H
@@ -0,0 +1,119 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "common/log.h"
+#include "gen/generator.h"
+#include "io/options.h"
+
+namespace {
+
+// projectorrays-gen's options. Its one command has no name, so it's implied.
+class GeneratorArgs : public IO::Options {
+public:
+	static constexpr IO::Command kCmdGenerate = static_cast<IO::Command>(1);
+
+	GeneratorArgs() : IO::Options(EmptyTable()) {
+		addCommand(kCmdGenerate, "", "Generate a synthetic Director movie for benchmarking and fuzzing.", "output path");
+
+		std::vector<EnumOptionInfo> containers = {
+			{ "rifx",			Gen::kContainerRIFX,		"Uncompressed RIFX movie" },
+			{ "afterburner",	Gen::kContainerAfterburner,	"Afterburner-compressed movie" }
+		};
+		addEnumOption(false, kCmdGenerate, "format", "Container format. Options are:", "name", containers, '\0', "rifx");
+		std::vector<EnumOptionInfo> byteOrders = {
+			{ "big",	Common::kBigEndian,		"Big endian, as written on Macs" },
+			{ "little",	Common::kLittleEndian,	"Little endian, as written on Windows" }
+		};
+		addEnumOption(false, kCmdGenerate, "endian", "Byte order. Options are:", "name", byteOrders, '\0', "big");
+		addOption(false, kCmdGenerate, "cast", "Write a cast file instead of a movie.");
+		addUnsignedOption(false, kCmdGenerate, "version", "Director version, 500-1200. Default is 850.", "number");
+		std::vector<EnumOptionInfo> compressions = {
+			{ "none",	Gen::kCompressionNone,	"Store chunks uncompressed" },
+			{ "zlib",	Gen::kCompressionZlib,	"Compress chunks with zlib" }
+		};
+		addEnumOption(false, kCmdGenerate, "compression", "Chunk compression, Afterburner only. Options are:", "name", compressions, '\0', "zlib");
+		addUnsignedOption(false, kCmdGenerate, "level", "zlib level, 0-9. Default is 6.", "number");
+		addUnsignedOption(false, kCmdGenerate, "seed", "Random seed. Default is 1.", "number");
+
+		addUnsignedOption(false, kCmdGenerate, "casts", "Number of casts. Default is 1.", "count");
+		addUnsignedOption(false, kCmdGenerate, "scripts", "Script members per cast. Default is 8.", "count");
+		addUnsignedOption(false, kCmdGenerate, "handlers", "Handlers per script. Default is 4.", "count");
+		addUnsignedOption(false, kCmdGenerate, "statements", "Statements per handler. Default is 16.", "count");
+		addUnsignedOption(false, kCmdGenerate, "literals", "Literals per script. Default is 8.", "count");
+		addUnsignedOption(false, kCmdGenerate, "string-literals", "Share of string literals. Default is 50.", "percent");
+		addUnsignedOption(false, kCmdGenerate, "float-literals", "Share of float literals. Default is 25.", "percent");
+		addUnsignedOption(false, kCmdGenerate, "bitmaps", "Bitmap members per cast. Default is 0.", "count");
+		addUnsignedOption(false, kCmdGenerate, "bitmap-size", "Size of each bitmap's data. Default is 4096.", "bytes");
+		addUnsignedOption(false, kCmdGenerate, "sounds", "Sound members per cast. Default is 0.", "count");
+		addUnsignedOption(false, kCmdGenerate, "sound-frames", "MP3 frames per sound. Default is 38.", "count");
+		addUnsignedOption(false, kCmdGenerate, "skip-samples", "Leading samples each sound discards. Default is 576.", "count");
+		addOption(false, kCmdGenerate, "sound-noise", "Fill MP3 frames with noise instead of silence.");
+	}
+};
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+	GeneratorArgs args;
+	args.parse(argc, argv);
+	if (!args.valid())
+		return EXIT_FAILURE;
+
+	Gen::GeneratorOptions options;
+	if (args.hasOption("format"))
+		options.container = static_cast<Gen::Container>(args.enumValue("format"));
+	if (args.hasOption("endian"))
+		options.endianness = static_cast<Common::Endianness>(args.enumValue("endian"));
+	options.isCast = args.hasOption("cast");
+	if (args.hasOption("compression"))
+		options.compression = static_cast<Gen::Compression>(args.enumValue("compression"));
+
+	auto setNumber = [&args](const char *name, auto &field) {
+		if (args.hasOption(name))
+			field = args.unsignedValue(name);
+	};
+	setNumber("version", options.version);
+	setNumber("level", options.compressionLevel);
+	setNumber("seed", options.seed);
+	setNumber("casts", options.castCount);
+	setNumber("scripts", options.scriptsPerCast);
+	setNumber("handlers", options.handlersPerScript);
+	setNumber("statements", options.statementsPerHandler);
+	setNumber("literals", options.literalsPerScript);
+	setNumber("string-literals", options.stringLiteralPercent);
+	setNumber("float-literals", options.floatLiteralPercent);
+	setNumber("bitmaps", options.bitmapsPerCast);
+	setNumber("bitmap-size", options.bitmapSize);
+	setNumber("sounds", options.soundsPerCast);
+	setNumber("sound-frames", options.soundFrames);
+	setNumber("skip-samples", options.soundSkipSamples);
+	options.soundNoise = args.hasOption("sound-noise");
+
+	std::string output = args.inputFile();
+	try {
+		Gen::Generator generator(options);
+		std::ofstream out(output, std::ios::binary);
+		if (!out)
+			throw std::runtime_error("Could not open " + output + " for writing");
+		generator.write(out);
+		out.close();
+		if (!out)
+			throw std::runtime_error("Could not write " + output);
+
+		Common::log(boost::format("Wrote %s (%zu bytes)") % output % generator.size());
+	} catch (const std::exception &e) {
+		Common::warning(e.what());
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
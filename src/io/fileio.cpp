@@ -4,14 +4,42 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include <cstdio>
 #include <iostream>
 #include <fstream>
 
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "io/fileio.h"
 #include "common/stream.h"
 
 namespace IO {
 
+thread_local uint64_t g_bytesWritten = 0;
+
+static thread_local FileSink *t_fileSink = nullptr;
+
+void setThreadFileSink(FileSink *sink) {
+	t_fileSink = sink;
+}
+
+FileSink *threadFileSink() {
+	return t_fileSink;
+}
+
+void createDirectory(const std::filesystem::path &path) {
+	if (!t_fileSink)
+		std::filesystem::create_directory(path);
+}
+
 bool readFile(const std::filesystem::path &path, std::vector<uint8_t> &buf) {
 	std::ifstream f;
 	f.open(path, std::ios::in | std::ios::binary);
@@ -29,24 +57,140 @@ bool readFile(const std::filesystem::path &path, std::vector<uint8_t> &buf) {
 	return true;
 }
 
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+	if (_buf.empty() && _data)
+		munmap(_data, _size);
+#endif
+}
+
+bool MappedFile::open(const std::filesystem::path &path) {
+#ifndef _WIN32
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return false;
+	struct stat st;
+	if (fstat(fd, &st) == -1) {
+		close(fd);
+		return false;
+	}
+	_size = st.st_size;
+	if (_size > 0) {
+		void *addr = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (addr != MAP_FAILED) {
+			_data = (uint8_t *)addr;
+			close(fd);
+			return true;
+		}
+	}
+	close(fd);
+#endif
+	if (!readFile(path, _buf))
+		return false;
+	_data = _buf.data();
+	_size = _buf.size();
+	return true;
+}
+
+bool readStdin(std::vector<uint8_t> &buf) {
+#ifdef _WIN32
+	_setmode(_fileno(stdin), _O_BINARY);
+#endif
+	// stdin can't seek, so read until EOF in blocks
+	buf.clear();
+	uint8_t block[65536];
+	size_t count;
+	while ((count = std::fread(block, 1, sizeof(block), stdin)) > 0) {
+		buf.insert(buf.end(), block, block + count);
+	}
+	return !std::ferror(stdin);
+}
+
+void setStdoutBinary() {
+#ifdef _WIN32
+	_setmode(_fileno(stdout), _O_BINARY);
+#endif
+}
+
 void writeFile(const std::filesystem::path &path, const std::string &contents) {
+	if (t_fileSink) {
+		writeFile(path, (const uint8_t *)contents.data(), contents.size());
+		return;
+	}
+
 	std::ofstream f;
 	f.open(path, std::ios::out | std::ios::binary);
 	f << contents;
 	f.close();
+	g_bytesWritten += contents.size();
 }
 
 void writeFile(const std::filesystem::path &path, const uint8_t *contents, size_t size) {
+	if (t_fileSink) {
+		t_fileSink->writeFile(path, contents, size);
+		g_bytesWritten += size;
+		return;
+	}
+
 	std::ofstream f;
 	f.open(path, std::ios::out | std::ios::binary);
 	f.write((char *)contents, size);
 	f.close();
+	g_bytesWritten += size;
 }
 
 void writeFile(const std::filesystem::path &path, const Common::BufferView &view) {
 	writeFile(path, view.data(), view.size());
 }
 
+void appendLine(const std::filesystem::path &path, const std::string &line) {
+	std::ofstream f;
+	f.open(path, std::ios::out | std::ios::binary | std::ios::app);
+	f << line << kPlatformLineEnding;
+	f.close();
+}
+
+/* FileWriter */
+
+bool FileWriter::open(const std::filesystem::path &path) {
+	close();
+	_path = path;
+	_sink = t_fileSink;
+	if (!_sink) {
+		_file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!_file.is_open())
+			return false;
+	}
+	_open = true;
+	return true;
+}
+
+void FileWriter::write(const uint8_t *data, size_t size) {
+	if (_sink) {
+		_buf.insert(_buf.end(), data, data + size);
+		return;
+	}
+	_file.write((const char *)data, size);
+	g_bytesWritten += size;
+}
+
+bool FileWriter::close() {
+	if (!_open)
+		return true;
+
+	_open = false;
+	if (_sink) {
+		_sink->writeFile(_path, _buf.data(), _buf.size());
+		g_bytesWritten += _buf.size();
+		_buf = std::vector<uint8_t>();
+		return true;
+	}
+	_file.close();
+	bool ok = !_file.fail();
+	_file.clear();
+	return ok;
+}
+
 std::string cleanFileName(const std::string &fileName) {
 	// Replace any characters that are forbidden in a Windows file name
 	// https://docs.microsoft.com/en-us/windows/win32/fileio/naming-a-file
@@ -9,6 +9,7 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <memory>
 #include <string>
 #include <vector>
@@ -20,16 +21,91 @@ class BufferView;
 namespace IO {
 
 #ifdef _WIN32
-static const char *kPlatformLineEnding = "\r\n";
+static const char *const kPlatformLineEnding = "\r\n";
 #else
-static const char *kPlatformLineEnding = "\n";
+static const char *const kPlatformLineEnding = "\n";
 #endif
 
+// Running total of the bytes written by writeFile on the calling thread
+extern thread_local uint64_t g_bytesWritten;
+
+/**
+ * FileSink receives the files written with writeFile on one thread in place
+ * of the filesystem, e.g. to stream them into an archive. Directories are
+ * implied by the paths.
+ */
+
+class FileSink {
+public:
+	virtual ~FileSink() = default;
+	virtual void writeFile(const std::filesystem::path &path, const uint8_t *contents, size_t size) = 0;
+};
+
+// Sets the calling thread's sink, or restores the filesystem if it is null
+void setThreadFileSink(FileSink *sink);
+FileSink *threadFileSink();
+
+// Does nothing while a sink is set
+void createDirectory(const std::filesystem::path &path);
+
 bool readFile(const std::filesystem::path &path, std::vector<uint8_t> &buf);
 
+/**
+ * MappedFile maps a file into memory, so only the pages that are read are
+ * loaded from disk. The mapping is read-only, so the data must not be
+ * written through. Where mapping isn't supported, the whole file is read.
+ */
+
+class MappedFile {
+private:
+	uint8_t *_data = nullptr;
+	size_t _size = 0;
+	std::vector<uint8_t> _buf;
+
+public:
+	MappedFile() = default;
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+	~MappedFile();
+
+	bool open(const std::filesystem::path &path);
+	uint8_t *data() const { return _data; }
+	size_t size() const { return _size; }
+};
+
+bool readStdin(std::vector<uint8_t> &buf);
+void setStdoutBinary();
+
 void writeFile(const std::filesystem::path &path, const std::string &contents);
 void writeFile(const std::filesystem::path &path, const uint8_t *contents, size_t size);
 void writeFile(const std::filesystem::path &path, const Common::BufferView &view);
+void appendLine(const std::filesystem::path &path, const std::string &line);
+
+/**
+ * FileWriter writes a file a block at a time, so its contents are never held
+ * in memory. A sink takes whole files, so while the calling thread has one
+ * the blocks are collected and passed to it on close.
+ */
+
+class FileWriter {
+private:
+	std::filesystem::path _path;
+	FileSink *_sink = nullptr;
+	std::vector<uint8_t> _buf;
+	std::ofstream _file;
+	bool _open = false;
+
+public:
+	FileWriter() = default;
+	FileWriter(const FileWriter &) = delete;
+	FileWriter &operator=(const FileWriter &) = delete;
+	~FileWriter() { close(); }
+
+	bool open(const std::filesystem::path &path);
+	void write(const uint8_t *data, size_t size);
+	// Returns false if any write failed
+	bool close();
+};
 
 std::string cleanFileName(const std::string &fileName);
 
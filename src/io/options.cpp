@@ -10,7 +10,9 @@
 
 namespace fs = std::filesystem;
 
+#include "director/sound.h"
 #include "io/options.h"
+#include "io/symbolindex.h"
 #include "common/log.h"
 #include "common/util.h"
 
@@ -18,8 +20,14 @@ namespace IO {
 
 Options::Options() {
 	addCommand(kCmdDecompile, "decompile", "Unprotect a movie, cast, or directory thereof, and decompile its scripts.");
-	addStringOption(false, kCmdDecompile, "output", "Output path. Default is chosen based on the input path.", "path", 'o');
-	addOption(false, kCmdAll, "dump-scripts", "Dump scripts.");
+	addStringOption(false, kCmdDecompile, "output", "Output path, or - for stdout. Default is chosen based on the input path.", "path", 'o');
+	addOption(false, kCmdDecompile | kCmdVersion, "dump-scripts", "Dump scripts.");
+	addOption(false, kCmdDecompile, "dump-sounds", "Dump sound members as audio files.");
+	std::vector<EnumOptionInfo> soundFormats = {
+		{ "wav",	Director::kSoundFileWAV,	"RIFF WAVE" },
+		{ "aiff",	Director::kSoundFileAIFF,	"Audio Interchange File Format" }
+	};
+	addEnumOption(false, kCmdDecompile, "sound-format", "Format of the sounds dumped by --dump-sounds. Options are:", "name", soundFormats, '\0', "wav");
 
 	addCommand(kCmdVersion, "version", "Print the Director version with which the file was created.");
 	std::vector<EnumOptionInfo> versionStyles = {
@@ -30,13 +38,50 @@ Options::Options() {
 	};
 	addEnumOption(false, kCmdVersion, "style", "Style in which to print the version. Options are:", "name", versionStyles, '\0', "long");
 
+	addCommand(kCmdExtract, "extract", "Decompile the script of one cast member, reading only the chunks it needs.");
+	addStringOption(false, kCmdExtract, "cast", "Name of the member's cast. Default is \"Internal\".", "name");
+	addUnsignedOption(false, kCmdExtract, "member", "Number of the member.", "number");
+	addOption(false, kCmdExtract, "bytecode", "Print the bytecode instead of the source.");
+
+	addCommand(kCmdScan, "scan", "Print a JSON line describing each file's chunks and casts, without decompressing or decompiling. Directories are searched recursively.");
+
+	addCommand(kCmdIndex, "index", "Build an index of the handlers, calls, globals, properties, symbols, strings, and castLibs used by the scripts in a file or directory tree.");
+	addStringOption(false, kCmdIndex | kCmdQuery, "index", "Path of the index file.", "path");
+	addOption(false, kCmdIndex, "parse", "Decompile the scripts to also find castLibs used in member expressions. Slower.");
+
+	addCommand(kCmdQuery, "query", "Print the files in an index that use a symbol. A trailing * matches any symbol starting with the term.", "term");
+	std::vector<EnumOptionInfo> symbolKinds = {
+		{ "any",		kSymbolKindCount,	"Any of the below" },
+		{ "name",		kSymbolName,		"Any name in a script's name table" },
+		{ "handler",	kSymbolHandler,		"Handler definitions" },
+		{ "call",		kSymbolCall,		"Handlers and methods called by name" },
+		{ "global",		kSymbolGlobal,		"Global variables" },
+		{ "property",	kSymbolProperty,	"Script, object, and `the` properties" },
+		{ "symbol",		kSymbolSymbol,		"#symbol literals" },
+		{ "string",		kSymbolString,		"String literals" },
+		{ "castLib",	kSymbolCastLib,		"castLibs referred to by name or number" }
+	};
+	addEnumOption(false, kCmdQuery, "kind", "Kind of symbol to match. Options are:", "kind", symbolKinds, '\0', "any");
+
+	addCommand(kCmdServe, "serve", "Process requests from local clients over a Unix domain socket.", nullptr);
+	addStringOption(false, kCmdServe, "socket", "Path of the socket to listen on.", "path");
+
+	addStringOption(false, kCmdDecompile | kCmdVersion | kCmdExtract | kCmdScan | kCmdIndex, "files-from", "Process the files listed in a file, or - for stdin, one per line, and print a JSON line for each.", "path");
+	addOption(false, kCmdDecompile | kCmdVersion | kCmdExtract | kCmdScan | kCmdIndex, "null", "The --files-from list is separated by NUL characters instead of newlines.", '0');
+	addUnsignedOption(false, kCmdDecompile | kCmdVersion | kCmdExtract | kCmdScan | kCmdIndex | kCmdServe, "jobs", "Number of files to process at once with --files-from, scan, index, or serve, or of sounds to decode at once otherwise. Default is one per CPU.", "count", 'j');
+	addStringOption(false, kCmdDecompile | kCmdExtract | kCmdServe, "script-cache", "Keep decompiled scripts in a directory, so identical scripts are reused by later runs.", "path");
+	addUnsignedOption(false, kCmdDecompile | kCmdExtract | kCmdServe, "script-cache-size", "Delete the least recently used scripts in the --script-cache directory beyond this many megabytes. Default is 1024.", "megabytes");
+	addUnsignedOption(false, kCmdDecompile | kCmdVersion | kCmdExtract, "memory-budget", "Evict re-derivable decompressed chunk data beyond this many megabytes.", "megabytes");
+	addOption(false, kCmdDecompile | kCmdVersion | kCmdExtract, "stats", "Print per-file statistics as JSON lines.");
+	addStringOption(false, kCmdDecompile | kCmdVersion | kCmdExtract, "stats-file", "Append per-file statistics to a file instead of printing them.", "path");
+
 	addOption(true, kCmdAll, "verbose", "Verbose logging", 'v');
-	addOption(true, kCmdAll, "dump-chunks", "Dump chunk data.");
-	addOption(true, kCmdAll, "dump-json", "Dump JSONified chunk data.");
+	addOption(true, kCmdDecompile | kCmdVersion | kCmdExtract, "dump-chunks", "Dump chunk data.");
+	addOption(true, kCmdDecompile | kCmdVersion | kCmdExtract, "dump-json", "Dump JSONified chunk data.");
 };
 
-void Options::addCommand(Command cmd, const char *name, const char *desc) {
-	_commandInfo.push_back({ cmd, name, desc });
+void Options::addCommand(Command cmd, const char *name, const char *desc, const char *inputName) {
+	_commandInfo.push_back({ cmd, name, desc, inputName });
 }
 
 Command Options::getCommand(std::string name) {
@@ -47,6 +92,12 @@ Command Options::getCommand(std::string name) {
 	return kCmdNone;
 }
 
+Command Options::impliedCommand() {
+	if (_commandInfo.size() == 1 && _commandInfo[0].name[0] == '\0')
+		return _commandInfo[0].cmd;
+	return kCmdNone;
+}
+
 std::string Options::getCommandName(Command cmd) {
 	for (const CommandInfo &info : _commandInfo) {
 		if (cmd == info.cmd)
@@ -63,6 +114,14 @@ std::string Options::getCommandDesc(Command cmd) {
 	return "";
 }
 
+const char *Options::getCommandInputName(Command cmd) {
+	for (const CommandInfo &info : _commandInfo) {
+		if (cmd == info.cmd)
+			return info.inputName;
+	}
+	return "input path";
+}
+
 void Options::addOption(bool debug, unsigned int cmd, const char *longName, const char *desc, char shortName) {
 	OptionInfo opt;
 	opt.debug = debug;
@@ -85,6 +144,19 @@ void Options::addStringOption(bool debug, unsigned int cmd, const char *longName
 	_optionInfo.push_back(opt);
 }
 
+void Options::addUnsignedOption(bool debug, unsigned int cmd, const char *longName, const char *desc, const char *argName, char shortName, const char *def) {
+	OptionInfo opt;
+	opt.debug = debug;
+	opt.cmd = cmd;
+	opt.longName = longName;
+	opt.desc = desc;
+	opt.isUnsigned = true;
+	opt.argName = argName;
+	opt.shortName = shortName;
+	opt.def = def;
+	_optionInfo.push_back(opt);
+}
+
 void Options::addEnumOption(bool debug, unsigned int cmd, const char *longName, const char *desc, const char *argName, std::vector<EnumOptionInfo> enumInfo, char shortName, const char *def) {
 	OptionInfo opt;
 	opt.debug = debug;
@@ -126,13 +198,21 @@ void Options::parse(int argc, char *argv[]) {
 	_optionsNoArg.clear();
 	_stringOptions.clear();
 	_enumOptions.clear();
+	_unsignedOptions.clear();
 
 	int argsStart = 2;
 
 	if (argc > 0) {
 		_programName = fs::path(argv[0]).filename().string();
 	}
-	if (argc > 1) {
+	if (impliedCommand() != kCmdNone) {
+		_cmd = impliedCommand();
+		argsStart = 1;
+		if (argc < 2) {
+			printUsage(stdout);
+			return;
+		}
+	} else if (argc > 1) {
 		std::string cmdString = argv[1];
 		_cmd = getCommand(cmdString);
 		if (_cmd == kCmdNone) {
@@ -152,13 +232,7 @@ void Options::parse(int argc, char *argv[]) {
 
 	for (int i = argsStart; i < argc; i++) {
 		std::string arg = argv[i];
-		if (arg.size() > 0 && arg[0] == '-') {
-			if (arg.size() == 1) {
-				Common::warning("Unknown option: -\n");
-				printUsage();
-				return;
-			}
-
+		if (arg.size() > 1 && arg[0] == '-') { // a lone - is stdin or stdout
 			std::string optionString;
 			const OptionInfo *info = nullptr;
 			bool optionArgFound = false;
@@ -232,6 +306,20 @@ void Options::parse(int argc, char *argv[]) {
 						return;
 					}
 					_enumOptions[info->longName] = value;
+				} else if (info->isUnsigned) {
+					size_t end = 0;
+					unsigned long long value = 0;
+					try {
+						value = std::stoull(optionArg, &end);
+					} catch (const std::exception &) {
+						end = 0;
+					}
+					if (optionArg.empty() || end != optionArg.size() || optionArg[0] == '-') {
+						Common::warning("Invalid argument for " + optionString + ": " + optionArg + "\n");
+						printUsage();
+						return;
+					}
+					_unsignedOptions[info->longName] = value;
 				} else {
 					_stringOptions[info->longName] = optionArg;
 				}
@@ -242,7 +330,7 @@ void Options::parse(int argc, char *argv[]) {
 			} else {
 				_optionsNoArg.insert(info->longName);
 			}
-		} else if (!inputFileFound) {
+		} else if (!inputFileFound && getCommandInputName(_cmd)) {
 			_inputFile = arg;
 			inputFileFound = true;
 		} else {
@@ -252,8 +340,14 @@ void Options::parse(int argc, char *argv[]) {
 		}
 	}
 
-	if (!inputFileFound) {
-		Common::warning("Input file not specified\n");
+	bool hasFileList = _stringOptions.count("files-from") > 0;
+	if (!inputFileFound && getCommandInputName(_cmd) && !hasFileList) {
+		Common::warning(std::string("No ") + getCommandInputName(_cmd) + " specified\n");
+		printUsage();
+		return;
+	}
+	if (inputFileFound && hasFileList) {
+		Common::warning("An input path cannot be used with --files-from\n");
 		printUsage();
 		return;
 	}
@@ -262,7 +356,12 @@ void Options::parse(int argc, char *argv[]) {
 };
 
 void Options::printUsage(FILE *fh) {
-	fprintf(fh, "Usage: %s <command> <input path> [<option>...]\n\n", _programName.c_str());
+	Command implied = impliedCommand();
+	if (implied != kCmdNone) {
+		fprintf(fh, "Usage: %s <%s> [<option>...]\n\n", _programName.c_str(), getCommandInputName(implied));
+	} else {
+		fprintf(fh, "Usage: %s <command> <input path> [<option>...]\n\n", _programName.c_str());
+	}
 
 	if (_cmd == kCmdNone || _cmd == kCmdAll) {
 		fputs("The following commands are available:\n", fh);
@@ -278,7 +377,9 @@ void Options::printUsage(FILE *fh) {
 			optionTexts.push_back(getOptionText(info.cmd, false));
 		}
 	}
-	optionTexts.push_back(getOptionText(kCmdAll, true));
+	auto debugText = getOptionText(kCmdAll, true);
+	if (debugText.size() > 1)
+		optionTexts.push_back(debugText);
 
 	size_t leftColWidth = 0;
 	for (const auto &optionText : optionTexts) {
@@ -314,7 +415,15 @@ void Options::printUsage(FILE *fh) {
 std::vector<std::pair<std::string, std::string>> Options::getOptionText(Command cmd, bool debug) {
 	std::vector<std::pair<std::string, std::string>> res;
 	if (cmd != kCmdNone && cmd != kCmdAll) {
-		res.push_back(std::make_pair(getCommandName(cmd) + " <input path>", getCommandDesc(cmd)));
+		std::string usage = getCommandName(cmd);
+		if (getCommandInputName(cmd)) {
+			if (!usage.empty())
+				usage += " ";
+			usage += "<";
+			usage += getCommandInputName(cmd);
+			usage += ">";
+		}
+		res.push_back(std::make_pair(usage, getCommandDesc(cmd)));
 	} else if (debug) {
 		res.push_back(std::make_pair("Debug options:", ""));
 	}
@@ -357,12 +466,18 @@ std::vector<std::pair<std::string, std::string>> Options::getOptionText(Command
 	return res;
 }
 
+size_t Options::memoryBudget() const {
+	if (!hasOption("memory-budget"))
+		return 0;
+	return unsignedValue("memory-budget") * 1024 * 1024;
+}
+
 bool Options::hasDumpOptions() const {
 	return hasCastDumpOptions() || hasChunkDumpOptions();
 }
 
 bool Options::hasCastDumpOptions() const {
-	return hasOption("dump-scripts");
+	return hasOption("dump-scripts") || hasOption("dump-sounds");
 }
 
 bool Options::hasChunkDumpOptions() const {
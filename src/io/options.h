@@ -20,7 +20,12 @@ enum Command {
 	kCmdNone		= 0,
 	kCmdDecompile	= (1 << 0),
 	kCmdVersion		= (1 << 1),
-	kCmdAll			= (1 << 2) - 1
+	kCmdServe		= (1 << 2),
+	kCmdExtract		= (1 << 3),
+	kCmdScan		= (1 << 4),
+	kCmdIndex		= (1 << 5),
+	kCmdQuery		= (1 << 6),
+	kCmdAll			= (1 << 7) - 1
 };
 
 enum VersionStyle {
@@ -31,17 +36,31 @@ enum VersionStyle {
 };
 
 class Options {
-private:
-	struct CommandInfo {
-		Command cmd;
+protected:
+	struct EnumOptionInfo {
 		const char *name;
+		unsigned int value;
 		const char *desc;
 	};
 
-	struct EnumOptionInfo {
+	// Starts with no commands or options, for a tool which adds its own. If
+	// its only command has an empty name, that command is implied and the
+	// tool takes no command argument.
+	struct EmptyTable {};
+	explicit Options(EmptyTable) {}
+
+	void addCommand(Command cmd, const char *name, const char *desc, const char *inputName = "input path");
+	void addOption(bool debug, unsigned int cmd, const char *longName, const char *desc, char shortName = '\0');
+	void addStringOption(bool debug, unsigned int cmd, const char *longName, const char *desc, const char *argName, char shortName = '\0', const char *def = nullptr);
+	void addUnsignedOption(bool debug, unsigned int cmd, const char *longName, const char *desc, const char *argName, char shortName = '\0', const char *def = nullptr);
+	void addEnumOption(bool debug, unsigned int cmd, const char *longName, const char *desc, const char *argName, std::vector<EnumOptionInfo> enumInfo, char shortName = '\0', const char *def = nullptr);
+
+private:
+	struct CommandInfo {
+		Command cmd;
 		const char *name;
-		unsigned int value;
 		const char *desc;
+		const char *inputName; // null if the command takes no input
 	};
 
 	struct OptionInfo {
@@ -49,6 +68,7 @@ private:
 		unsigned int cmd = kCmdNone;
 		const char *longName = nullptr;
 		const char *desc = nullptr;
+		bool isUnsigned = false;
 		std::vector<EnumOptionInfo> enumInfo;
 		char shortName = '\0';
 		const char *argName = nullptr;
@@ -67,15 +87,14 @@ private:
 	std::set<std::string> _optionsNoArg;
 	std::map<std::string, std::string> _stringOptions;
 	std::map<std::string, unsigned int> _enumOptions;
+	std::map<std::string, unsigned long long> _unsignedOptions;
 
-	void addCommand(Command cmd, const char *name, const char *desc);
 	Command getCommand(std::string name);
+	Command impliedCommand();
 	std::string getCommandName(Command cmd);
 	std::string getCommandDesc(Command cmd);
+	const char *getCommandInputName(Command cmd);
 
-	void addOption(bool debug, unsigned int cmd, const char *longName, const char *desc, char shortName = '\0');
-	void addStringOption(bool debug, unsigned int cmd, const char *longName, const char *desc, const char *argName, char shortName = '\0', const char *def = nullptr);
-	void addEnumOption(bool debug, unsigned int cmd, const char *longName, const char *desc, const char *argName, std::vector<EnumOptionInfo> enumInfo, char shortName = '\0', const char *def = nullptr);
 	const OptionInfo *getOptionInfo(std::string longName);
 	const OptionInfo *getOptionInfo(char shortName);
 
@@ -90,12 +109,14 @@ public:
 	bool valid() const { return _valid; }
 	Command cmd() const { return _cmd; }
 	std::string inputFile() const { return _inputFile; }
-	bool hasOption(std::string option) const { return _optionsNoArg.count(option) || _stringOptions.count(option) || _enumOptions.count(option); }
+	bool hasOption(std::string option) const { return _optionsNoArg.count(option) || _stringOptions.count(option) || _enumOptions.count(option) || _unsignedOptions.count(option); }
 	bool hasDumpOptions() const;
 	bool hasCastDumpOptions() const;
 	bool hasChunkDumpOptions() const;
 	std::string stringValue(std::string option) const { return _stringOptions.at(option); }
 	unsigned int enumValue(std::string option) const { return _enumOptions.at(option); }
+	unsigned long long unsignedValue(std::string option) const { return _unsignedOptions.at(option); }
+	size_t memoryBudget() const;
 };
 
 } // namespace IO
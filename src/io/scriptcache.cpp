@@ -0,0 +1,192 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <system_error>
+#include <vector>
+
+#include "io/scriptcache.h"
+
+namespace fs = std::filesystem;
+
+namespace IO {
+
+static const char *kStoreExtension = ".txt";
+
+// A temporary file this old was left by a writer that died
+static const auto kStaleTempAge = std::chrono::hours(1);
+
+void ScriptCache::setStore(const fs::path &dir, uint64_t capacity) {
+	fs::create_directories(dir);
+	_storeDir = dir;
+	_storeCapacity = capacity;
+	_storeSize = 0;
+	_storeSizeKnown = false;
+}
+
+// Returns the size of the entries in the store. If prune is set, deletes
+// the least recently used ones until the store is under 3/4 of its limit.
+uint64_t ScriptCache::scanStore(bool prune) {
+	struct Entry {
+		fs::file_time_type time;
+		uint64_t size;
+		fs::path path;
+	};
+	std::vector<Entry> entries;
+	uint64_t size = 0;
+
+	std::error_code ec;
+	auto now = fs::file_time_type::clock::now();
+	for (fs::recursive_directory_iterator it(_storeDir, ec), end; !ec && it != end; it.increment(ec)) {
+		if (!it->is_regular_file(ec))
+			continue;
+
+		Entry entry;
+		entry.path = it->path();
+		entry.time = it->last_write_time(ec);
+		entry.size = it->file_size(ec);
+		if (ec) {
+			ec.clear(); // deleted by another process
+			continue;
+		}
+		if (entry.path.extension() != kStoreExtension) {
+			if (prune && now - entry.time > kStaleTempAge)
+				fs::remove(entry.path, ec);
+			continue;
+		}
+		size += entry.size;
+		if (prune)
+			entries.push_back(std::move(entry));
+	}
+	if (!prune)
+		return size;
+
+	std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+		return a.time < b.time;
+	});
+	uint64_t target = _storeCapacity / 4 * 3;
+	for (const Entry &entry : entries) {
+		if (size <= target)
+			break;
+		if (fs::remove(entry.path, ec) || !fs::exists(entry.path, ec))
+			size -= entry.size;
+	}
+	return size;
+}
+
+// Entries are spread over 256 subdirectories by the first byte of the key
+fs::path ScriptCache::storePath(const Common::Hash128 &key) const {
+	std::string name = key.toString();
+	return _storeDir / name.substr(0, 2) / (name + kStoreExtension);
+}
+
+bool ScriptCache::find(const Common::Hash128 &key, std::string &text) {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto it = _index.find(key);
+		if (it != _index.end()) {
+			_entries.splice(_entries.begin(), _entries, it->second);
+			text = it->second->second;
+			return true;
+		}
+	}
+
+	if (_storeDir.empty())
+		return false;
+
+	fs::path path = storePath(key);
+	std::ifstream f(path, std::ios::in | std::ios::binary);
+	if (!f.is_open())
+		return false;
+	text.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+	if (f.bad())
+		return false;
+	std::error_code ec;
+	fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	insertLocked(key, text);
+	return true;
+}
+
+void ScriptCache::insert(const Common::Hash128 &key, const std::string &text) {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		insertLocked(key, text);
+	}
+
+	if (_storeDir.empty())
+		return;
+
+	// The store is best effort, so failing to write it isn't an error
+	fs::path path = storePath(key);
+	std::error_code ec;
+	if (fs::exists(path, ec))
+		return;
+	fs::create_directories(path.parent_path(), ec);
+
+	// Other threads or processes may be writing the same entry
+	std::random_device random;
+	std::ostringstream tempName;
+	tempName << path.filename().string() << "." << std::hex << random() << random() << ".tmp";
+	fs::path tempPath = path.parent_path() / tempName.str();
+	{
+		std::ofstream f(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!f.is_open())
+			return;
+		f.write(text.data(), text.size());
+		if (!f) {
+			f.close();
+			fs::remove(tempPath, ec);
+			return;
+		}
+	}
+	fs::rename(tempPath, path, ec);
+	if (ec) {
+		fs::remove(tempPath, ec);
+		return;
+	}
+
+	// Only one thread scans at a time, without holding up the others
+	bool sizeKnown;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_storeSize += text.size();
+		if (_scanning || (_storeSizeKnown && _storeSize <= _storeCapacity))
+			return;
+		_scanning = true;
+		sizeKnown = _storeSizeKnown;
+	}
+	uint64_t size = scanStore(sizeKnown);
+	if (!sizeKnown && size > _storeCapacity)
+		size = scanStore(true);
+	std::lock_guard<std::mutex> lock(_mutex);
+	_storeSize = size;
+	_storeSizeKnown = true;
+	_scanning = false;
+}
+
+void ScriptCache::insertLocked(const Common::Hash128 &key, const std::string &text) {
+	if (_index.find(key) != _index.end() || text.size() > _capacity)
+		return;
+
+	_entries.emplace_front(key, text);
+	_index[key] = _entries.begin();
+	_size += text.size();
+	while (_size > _capacity) {
+		auto &oldest = _entries.back();
+		_size -= oldest.second.size();
+		_index.erase(oldest.first);
+		_entries.pop_back();
+	}
+}
+
+} // namespace IO
@@ -0,0 +1,77 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef IO_SCRIPTCACHE_H
+#define IO_SCRIPTCACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "common/hash.h"
+
+namespace IO {
+
+/**
+ * ScriptCache holds rendered script text by content key, so a script that
+ * appears in many files (a shared behavior library, say) is decompiled once
+ * per batch. It may be shared between threads.
+ *
+ * The most recently used texts are kept in memory up to a byte limit. If a
+ * store directory is set, every text is also written there and looked up on
+ * a miss, so later runs can reuse it. Entries are written to a temporary file
+ * and renamed into place, so concurrent runs can share a store.
+ *
+ * The store is bounded too. A hit refreshes the entry's modification time,
+ * and once the store grows past its limit the least recently used entries
+ * are deleted until it is back under three quarters of it. The store is
+ * only walked to find its size when this process first adds to it, so runs
+ * that only read from it stay cheap.
+ */
+
+class ScriptCache {
+public:
+	static const size_t kDefaultCapacity = 128 * 1024 * 1024;
+	static const uint64_t kDefaultStoreCapacity = 1024 * 1024 * 1024;
+
+private:
+	struct KeyHash {
+		size_t operator()(const Common::Hash128 &key) const { return key.h1; }
+	};
+	typedef std::list<std::pair<Common::Hash128, std::string>> EntryList;
+
+	size_t _capacity;
+	size_t _size = 0;
+	EntryList _entries; // most recently used first
+	std::unordered_map<Common::Hash128, EntryList::iterator, KeyHash> _index;
+	std::filesystem::path _storeDir;
+	uint64_t _storeCapacity = kDefaultStoreCapacity;
+	uint64_t _storeSize = 0; // as of the last scan, plus what this process added
+	bool _storeSizeKnown = false; // not until the store is first scanned
+	bool _scanning = false;
+	std::mutex _mutex;
+
+	void insertLocked(const Common::Hash128 &key, const std::string &text);
+	std::filesystem::path storePath(const Common::Hash128 &key) const;
+	uint64_t scanStore(bool prune);
+
+public:
+	ScriptCache(size_t capacity = kDefaultCapacity) : _capacity(capacity) {}
+
+	// Creates the directory if needed
+	void setStore(const std::filesystem::path &dir, uint64_t capacity = kDefaultStoreCapacity);
+
+	bool find(const Common::Hash128 &key, std::string &text);
+	void insert(const Common::Hash128 &key, const std::string &text);
+};
+
+} // namespace IO
+
+#endif // IO_SCRIPTCACHE_H
@@ -0,0 +1,397 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "common/json.h"
+#include "common/jsonreader.h"
+#include "common/log.h"
+#include "io/server.h"
+#include "io/stats.h"
+#include "io/threadpool.h"
+
+namespace IO {
+
+static const size_t kMaxHeaderSize = 1024 * 1024;
+static const size_t kMaxDataSize = 0x7FFFFFFF;
+// Data frames are buffered as they arrive rather than all at once, so a
+// client can't make us allocate more than it has actually sent
+static const size_t kDataReadSize = 16 * 1024 * 1024;
+
+/* Connection */
+
+#ifndef _WIN32
+
+class Connection {
+private:
+	int _fd;
+	std::mutex _writeMutex;
+	bool _broken = false;
+
+	bool readFully(uint8_t *dest, size_t size) {
+		while (size > 0) {
+			ssize_t res = ::read(_fd, dest, size);
+			if (res < 0 && errno == EINTR)
+				continue;
+			if (res <= 0)
+				return false;
+			dest += res;
+			size -= res;
+		}
+		return true;
+	}
+
+	bool writeFully(const uint8_t *src, size_t size) {
+		while (size > 0) {
+			ssize_t res = ::write(_fd, src, size);
+			if (res < 0 && errno == EINTR)
+				continue;
+			if (res <= 0)
+				return false;
+			src += res;
+			size -= res;
+		}
+		return true;
+	}
+
+	bool writeFrame(const uint8_t *data, size_t size) {
+		uint8_t len[4] = {
+			(uint8_t)(size >> 24), (uint8_t)(size >> 16), (uint8_t)(size >> 8), (uint8_t)size
+		};
+		return writeFully(len, 4) && writeFully(data, size);
+	}
+
+public:
+	Connection(int fd) : _fd(fd) {}
+	~Connection() { ::close(_fd); }
+
+	// Returns false at the end of the stream
+	bool readFrameSize(size_t &size) {
+		uint8_t len[4];
+		if (!readFully(len, 4))
+			return false;
+		size = ((size_t)len[0] << 24) | ((size_t)len[1] << 16) | ((size_t)len[2] << 8) | (size_t)len[3];
+		return true;
+	}
+
+	// Returns false at the end of the stream, or if the frame is too large
+	bool readFrame(std::vector<uint8_t> &frame, size_t maxSize) {
+		size_t size;
+		if (!readFrameSize(size) || size > maxSize)
+			return false;
+		frame.resize(size);
+		return readFully(frame.data(), size);
+	}
+
+	// Reads the body of a frame whose size has been read and checked
+	bool readFrameBody(std::vector<uint8_t> &frame, size_t size) {
+		frame.clear();
+		while (frame.size() < size) {
+			size_t start = frame.size();
+			frame.resize(start + std::min(size - start, kDataReadSize));
+			if (!readFully(frame.data() + start, frame.size() - start))
+				return false;
+		}
+		return true;
+	}
+
+	// Writes a header frame and, if data is given, a data frame after it.
+	// Messages from different jobs never interleave.
+	void writeMessage(const std::string &header, const uint8_t *data = nullptr, size_t size = 0) {
+		std::lock_guard<std::mutex> lock(_writeMutex);
+		if (_broken)
+			return; // the client went away; the job finishes regardless
+
+		bool ok = writeFrame((const uint8_t *)header.data(), header.size());
+		if (ok && data)
+			ok = writeFrame(data, size);
+		if (!ok)
+			_broken = true;
+	}
+
+	void shutdownRead() { ::shutdown(_fd, SHUT_RD); }
+};
+
+#else
+
+class Connection {
+public:
+	void writeMessage(const std::string &, const uint8_t * = nullptr, size_t = 0) {}
+};
+
+#endif
+
+/* ServeResponse */
+
+ServeResponse::ServeResponse(std::shared_ptr<Connection> connection, uint64_t id)
+	: _connection(std::move(connection)), _id(id) {}
+
+ServeResponse::~ServeResponse() {
+	if (!_finished)
+		result(false, "Request produced no result", nullptr);
+}
+
+void ServeResponse::log(bool isWarning, const std::string &msg) {
+	Common::JSONWriter json("", "", Common::kJSONStrict);
+	json.startObject();
+	json.writeField("id", _id);
+	json.writeField("type", "log");
+	json.writeField("level", isWarning ? "warning" : "info");
+	json.writeField("message", msg);
+	json.endObject();
+	_connection->writeMessage(json.str());
+}
+
+void ServeResponse::output(const std::string &name, const uint8_t *data, size_t size) {
+	if (size > kMaxDataSize)
+		throw std::runtime_error("Output " + name + " is too large to send");
+
+	Common::JSONWriter json("", "", Common::kJSONStrict);
+	json.startObject();
+	json.writeField("id", _id);
+	json.writeField("type", "output");
+	json.writeField("name", name);
+	json.writeField("dataSize", (uint64_t)size);
+	json.endObject();
+	_connection->writeMessage(json.str(), data, size);
+}
+
+void ServeResponse::result(bool success, const std::string &error, const FileStats *stats) {
+	if (_finished)
+		return;
+	_finished = true;
+
+	Common::JSONWriter json("", "", Common::kJSONStrict);
+	json.startObject();
+	json.writeField("id", _id);
+	json.writeField("type", "result");
+	json.writeField("success", success);
+	if (!error.empty())
+		json.writeField("error", error);
+	if (stats) {
+		json.writeKey("stats");
+		stats->writeJSON(json);
+	}
+	json.endObject();
+	_connection->writeMessage(json.str());
+}
+
+/* Server */
+
+Server::Server(const std::string &socketPath, size_t jobs, ServeHandler handler)
+	: _socketPath(socketPath), _jobs(jobs), _handler(std::move(handler)) {}
+
+#ifndef _WIN32
+
+static volatile sig_atomic_t g_stopRequested = 0;
+
+static void handleStopSignal(int) {
+	g_stopRequested = 1;
+}
+
+static ServeRequest readRequest(const std::vector<uint8_t> &frame, Connection &connection, bool &ok) {
+	ServeRequest request;
+	Common::JSONValue header = Common::parseJSON(std::string(frame.begin(), frame.end()));
+	if (header.has("id"))
+		request.id = (uint64_t)header["id"].asNumber();
+	for (const auto &arg : header["args"].asArray()) {
+		request.args.push_back(arg.asString());
+	}
+	if (header.has("dataSize")) {
+		double dataSize = header["dataSize"].asNumber();
+		if (!(dataSize >= 0 && dataSize <= kMaxDataSize) || dataSize != std::floor(dataSize))
+			throw std::runtime_error("Invalid dataSize");
+		request.hasData = true;
+		size_t frameSize;
+		ok = connection.readFrameSize(frameSize);
+		if (!ok)
+			return request;
+		if (frameSize != (size_t)dataSize)
+			throw std::runtime_error("Data frame does not match dataSize");
+		ok = connection.readFrameBody(request.data, frameSize);
+	}
+	return request;
+}
+
+// Deletes a socket left behind by a server that was killed. Anything else at
+// the path, including a socket a server is still listening on, is kept and
+// makes this return false.
+static bool removeStaleSocket(const std::string &path) {
+	struct stat st;
+	if (::lstat(path.c_str(), &st) < 0)
+		return errno == ENOENT;
+	if (!S_ISSOCK(st.st_mode)) {
+		Common::warning(path + " exists and is not a socket; not replacing it");
+		return false;
+	}
+
+	int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) {
+		Common::warning(std::string("Could not create socket: ") + std::strerror(errno));
+		return false;
+	}
+	sockaddr_un addr;
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+	bool refused = ::connect(fd, (sockaddr *)&addr, sizeof(addr)) < 0 && errno == ECONNREFUSED;
+	::close(fd);
+	if (!refused) {
+		Common::warning("Another server may be listening on " + path + "; not replacing it");
+		return false;
+	}
+	return ::unlink(path.c_str()) == 0 || errno == ENOENT;
+}
+
+// Reads requests from one client and queues them. The pool's bounded queue
+// makes a client that sends faster than we can process wait.
+static void readerLoop(std::shared_ptr<Connection> connection, ThreadPool &pool, const ServeHandler &handler) {
+	std::vector<uint8_t> frame;
+	while (connection->readFrame(frame, kMaxHeaderSize)) {
+		auto request = std::make_shared<ServeRequest>();
+		bool ok = true;
+		try {
+			*request = readRequest(frame, *connection, ok);
+		} catch (const std::exception &e) {
+			ServeResponse(connection, request->id).result(false, std::string("Bad request: ") + e.what(), nullptr);
+			return;
+		}
+		if (!ok)
+			return;
+
+		pool.enqueue([connection, request, &handler]() {
+			ServeResponse response(connection, request->id);
+			try {
+				handler(*request, response);
+			} catch (const std::exception &e) {
+				response.result(false, e.what(), nullptr);
+			}
+		});
+	}
+}
+
+bool Server::run() {
+	if (_socketPath.size() >= sizeof(sockaddr_un::sun_path)) {
+		Common::warning("Socket path is too long: " + _socketPath);
+		return false;
+	}
+
+	int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listenFd < 0) {
+		Common::warning(std::string("Could not create socket: ") + std::strerror(errno));
+		return false;
+	}
+
+	sockaddr_un addr;
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	std::strncpy(addr.sun_path, _socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+	if (!removeStaleSocket(_socketPath)) {
+		::close(listenFd);
+		return false;
+	}
+	if (::bind(listenFd, (sockaddr *)&addr, sizeof(addr)) < 0 || ::listen(listenFd, 16) < 0) {
+		Common::warning("Could not listen on " + _socketPath + ": " + std::strerror(errno));
+		::close(listenFd);
+		return false;
+	}
+
+	// A client hanging up mid-response must not kill the server, and
+	// SIGINT/SIGTERM should shut down cleanly rather than leave the socket.
+	std::signal(SIGPIPE, SIG_IGN);
+	struct sigaction action;
+	std::memset(&action, 0, sizeof(action));
+	action.sa_handler = handleStopSignal;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGINT, &action, nullptr);
+	sigaction(SIGTERM, &action, nullptr);
+	g_stopRequested = 0;
+
+	Common::log("Serving on " + _socketPath + " with " + std::to_string(_jobs) + " jobs");
+
+	{
+		ThreadPool pool(_jobs, _jobs * 4);
+
+		struct Reader {
+			std::thread thread;
+			std::weak_ptr<Connection> connection;
+			std::shared_ptr<std::atomic<bool>> done;
+		};
+		std::list<Reader> readers;
+
+		while (!g_stopRequested) {
+			// Join readers whose clients have disconnected
+			for (auto it = readers.begin(); it != readers.end();) {
+				if (*it->done) {
+					it->thread.join();
+					it = readers.erase(it);
+				} else {
+					++it;
+				}
+			}
+
+			pollfd pfd = { listenFd, POLLIN, 0 };
+			int res = ::poll(&pfd, 1, 250);
+			if (res <= 0)
+				continue; // timeout, or interrupted by a signal
+
+			int fd = ::accept(listenFd, nullptr, nullptr);
+			if (fd < 0)
+				continue;
+
+			auto connection = std::make_shared<Connection>(fd);
+			auto done = std::make_shared<std::atomic<bool>>(false);
+			std::thread thread([this, connection, done, &pool]() {
+				readerLoop(connection, pool, _handler);
+				*done = true;
+			});
+			readers.push_back({ std::move(thread), connection, done });
+		}
+
+		// Stop reading new requests. The pool then finishes the queued ones.
+		for (auto &reader : readers) {
+			if (auto connection = reader.connection.lock())
+				connection->shutdownRead();
+		}
+		for (auto &reader : readers) {
+			reader.thread.join();
+		}
+	}
+
+	::close(listenFd);
+	::unlink(_socketPath.c_str());
+	Common::log("Server stopped");
+	return true;
+}
+
+#else
+
+bool Server::run() {
+	Common::warning("serve is not supported on Windows");
+	return false;
+}
+
+#endif
+
+} // namespace IO
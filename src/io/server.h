@@ -0,0 +1,84 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef IO_SERVER_H
+#define IO_SERVER_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace IO {
+
+struct FileStats;
+class Connection;
+
+/**
+ * Server accepts requests over a Unix domain socket and runs them on a
+ * thread pool, so the process and its tables stay warm between files.
+ *
+ * Every message in either direction is a frame: a 32-bit big-endian length
+ * followed by that many bytes. Each message starts with a frame holding a
+ * JSON object. If the object has a "dataSize" field, a second frame with
+ * that many bytes of binary data follows.
+ *
+ * Requests look like
+ *   {"id": 1, "args": ["decompile", "movie.dcr", "-o", "out.dir"]}
+ * where args are the command line arguments without the program name. With
+ * "dataSize", the input path only names the file and the movie itself is
+ * sent inline. A connection may send any number of requests without
+ * waiting; they run concurrently.
+ *
+ * The server replies with any number of
+ *   {"id": 1, "type": "log", "level": "info"|"warning", "message": "..."}
+ *   {"id": 1, "type": "output", "name": "movie.dir", "dataSize": N} + data
+ * followed by exactly one
+ *   {"id": 1, "type": "result", "success": true, "error": "", "stats": {...}}
+ */
+
+struct ServeRequest {
+	uint64_t id = 0;
+	std::vector<std::string> args;
+	bool hasData = false;
+	std::vector<uint8_t> data;
+};
+
+class ServeResponse {
+private:
+	std::shared_ptr<Connection> _connection;
+	uint64_t _id;
+	bool _finished = false;
+
+public:
+	ServeResponse(std::shared_ptr<Connection> connection, uint64_t id);
+	~ServeResponse(); // sends a failed result if none was sent
+
+	void log(bool isWarning, const std::string &msg);
+	void output(const std::string &name, const uint8_t *data, size_t size);
+	void result(bool success, const std::string &error, const FileStats *stats);
+};
+
+typedef std::function<void(ServeRequest &request, ServeResponse &response)> ServeHandler;
+
+class Server {
+private:
+	std::string _socketPath;
+	size_t _jobs;
+	ServeHandler _handler;
+
+public:
+	Server(const std::string &socketPath, size_t jobs, ServeHandler handler);
+
+	// Serves until SIGINT or SIGTERM. Returns false if the socket couldn't
+	// be opened.
+	bool run();
+};
+
+} // namespace IO
+
+#endif // IO_SERVER_H
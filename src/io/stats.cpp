@@ -0,0 +1,255 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "common/json.h"
+#include "common/stream.h"
+#include "director/chunk.h"
+#include "director/dirfile.h"
+#include "director/guid.h"
+#include "io/stats.h"
+#include "lingodec/ast.h"
+#include "lingodec/handler.h"
+#include "lingodec/script.h"
+
+namespace IO {
+
+const char *stageName(Stage stage) {
+	switch (stage) {
+	case kStageRead:
+		return "read";
+	case kStageParse:
+		return "parse";
+	case kStageRestore:
+		return "restore";
+	case kStageWrite:
+		return "write";
+	case kStageDump:
+		return "dump";
+	default:
+		break;
+	}
+	return "unknown";
+}
+
+static double percentile(std::vector<double> values, double p) {
+	if (values.empty())
+		return 0.0;
+
+	// Nearest-rank method
+	std::sort(values.begin(), values.end());
+	size_t rank = (size_t)std::ceil(p / 100.0 * values.size());
+	if (rank < 1)
+		rank = 1;
+	return values[rank - 1];
+}
+
+static void writePercentilesJSON(Common::JSONWriter &json, const std::vector<double> &values) {
+	double total = 0.0;
+	for (double val : values) {
+		total += val;
+	}
+	json.startObject();
+		json.writeField("total", total);
+		json.writeField("p50", percentile(values, 50));
+		json.writeField("p90", percentile(values, 90));
+		json.writeField("p99", percentile(values, 99));
+		json.writeField("max", percentile(values, 100));
+	json.endObject();
+}
+
+/* FileStats */
+
+void FileStats::collect(const Director::DirectorFile &dir) {
+	version = dir.version;
+	codec = dir.codec;
+	memory = dir.memory;
+	scriptCacheHits = dir.scriptCacheHits;
+	scriptCacheMisses = dir.scriptCacheMisses;
+
+	chunkCounts.clear();
+	compression.clear();
+	for (const auto &[id, info] : dir.chunkInfo) {
+		chunkCounts[info.fourCC]++;
+
+		std::string key = info.compressionID.toString();
+		CompressionStats &entry = compression[key];
+		entry.name = Director::compressionName(info.compressionID);
+		entry.chunkCount++;
+		entry.compressedBytes += info.len;
+		entry.uncompressedBytes += info.uncompressedLen;
+	}
+
+	scriptCount = 0;
+	handlerCount = 0;
+	bytecodeCount = 0;
+	for (const auto *cast : dir.casts) {
+		if (!cast->lctx)
+			continue;
+
+		for (const auto &[scriptId, script] : cast->lctx->scripts) {
+			scriptCount++;
+			handlerCount += script->handlers.size();
+			for (const auto &handler : script->handlers) {
+				bytecodeCount += handler->bytecodeArray.size();
+			}
+		}
+	}
+}
+
+void FileStats::writeJSON(Common::JSONWriter &json) const {
+	json.startObject();
+		json.writeField("type", "file");
+		json.writeField("path", path);
+		json.writeField("success", success);
+		json.writeField("inputBytes", inputBytes);
+		json.writeField("bytesWritten", bytesWritten);
+		json.writeField("version", version);
+		json.writeFourCCField("codec", codec);
+		json.writeKey("stageTimes");
+		json.startObject();
+			for (int stage = 0; stage < kStageCount; stage++) {
+				json.writeField(stageName((Stage)stage), stageTimes[stage]);
+			}
+		json.endObject();
+		json.writeField("totalTime", totalTime);
+		json.writeField("peakRSS", (uint64_t)peakRSS);
+		json.writeKey("chunkCounts");
+		writeChunkCountsJSON(json, chunkCounts);
+		json.writeKey("compression");
+		writeCompressionJSON(json, compression);
+		json.writeField("scripts", (uint64_t)scriptCount);
+		json.writeField("handlers", (uint64_t)handlerCount);
+		json.writeField("bytecodes", (uint64_t)bytecodeCount);
+		json.writeField("scriptCacheHits", (uint64_t)scriptCacheHits);
+		json.writeField("scriptCacheMisses", (uint64_t)scriptCacheMisses);
+		json.writeKey("memory");
+		memory.writeJSON(json);
+	json.endObject();
+}
+
+std::string FileStats::jsonLine() const {
+	Common::JSONWriter json("", "", Common::kJSONStrict);
+	writeJSON(json);
+	return json.str();
+}
+
+void writeChunkCountsJSON(Common::JSONWriter &json, const std::map<uint32_t, size_t> &chunkCounts) {
+	json.startObject();
+		for (const auto &[fourCC, count] : chunkCounts) {
+			json.writeField(Common::rawFourCC(fourCC), (uint64_t)count);
+		}
+	json.endObject();
+}
+
+void writeCompressionJSON(Common::JSONWriter &json, const std::map<std::string, CompressionStats> &compression) {
+	json.startObject();
+		for (const auto &[guid, entry] : compression) {
+			json.writeKey(guid);
+			json.startObject();
+				json.writeField("name", entry.name);
+				json.writeField("chunks", (uint64_t)entry.chunkCount);
+				json.writeField("compressedBytes", entry.compressedBytes);
+				json.writeField("uncompressedBytes", entry.uncompressedBytes);
+			json.endObject();
+		}
+	json.endObject();
+}
+
+/* BatchStats */
+
+void BatchStats::add(const FileStats &stats) {
+	fileCount++;
+	if (!stats.success)
+		failureCount++;
+	inputBytes += stats.inputBytes;
+	bytesWritten += stats.bytesWritten;
+	scriptCount += stats.scriptCount;
+	handlerCount += stats.handlerCount;
+	bytecodeCount += stats.bytecodeCount;
+	scriptCacheHits += stats.scriptCacheHits;
+	scriptCacheMisses += stats.scriptCacheMisses;
+	totalTimes.push_back(stats.totalTime);
+	for (int stage = 0; stage < kStageCount; stage++) {
+		stageTimes[stage].push_back(stats.stageTimes[stage]);
+	}
+}
+
+void BatchStats::writeJSON(Common::JSONWriter &json) const {
+	double totalTime = 0.0;
+	for (double time : totalTimes) {
+		totalTime += time;
+	}
+
+	json.startObject();
+		json.writeField("type", "batch");
+		json.writeField("files", (uint64_t)fileCount);
+		json.writeField("failures", (uint64_t)failureCount);
+		json.writeField("inputBytes", inputBytes);
+		json.writeField("bytesWritten", bytesWritten);
+		json.writeField("scripts", (uint64_t)scriptCount);
+		json.writeField("handlers", (uint64_t)handlerCount);
+		json.writeField("bytecodes", (uint64_t)bytecodeCount);
+		json.writeField("scriptCacheHits", (uint64_t)scriptCacheHits);
+		json.writeField("scriptCacheMisses", (uint64_t)scriptCacheMisses);
+		// Fraction of rendered scripts that were reused rather than decompiled
+		size_t lookups = scriptCacheHits + scriptCacheMisses;
+		json.writeField("dedupRatio", (lookups > 0) ? (double)scriptCacheHits / lookups : 0.0);
+		json.writeField("inputMBPerSec", (totalTime > 0.0) ? inputBytes / totalTime / 1e6 : 0.0);
+		json.writeKey("totalTime");
+		writePercentilesJSON(json, totalTimes);
+		json.writeKey("stageTimes");
+		json.startObject();
+			for (int stage = 0; stage < kStageCount; stage++) {
+				json.writeKey(stageName((Stage)stage));
+				writePercentilesJSON(json, stageTimes[stage]);
+			}
+		json.endObject();
+		json.writeField("peakRSS", (uint64_t)peakRSS());
+	json.endObject();
+}
+
+std::string BatchStats::jsonLine() const {
+	Common::JSONWriter json("", "", Common::kJSONStrict);
+	writeJSON(json);
+	return json.str();
+}
+
+/* StageTimer */
+
+StageTimer::~StageTimer() {
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - _start;
+	_dest += elapsed.count();
+}
+
+size_t peakRSS() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return counters.PeakWorkingSetSize;
+	return 0;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#ifdef __APPLE__
+	return usage.ru_maxrss; // bytes
+#else
+	return (size_t)usage.ru_maxrss * 1024; // kilobytes
+#endif
+#endif
+}
+
+} // namespace IO
@@ -0,0 +1,112 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef IO_STATS_H
+#define IO_STATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/memory.h"
+
+namespace Common {
+class JSONWriter;
+}
+
+namespace Director {
+class DirectorFile;
+}
+
+namespace IO {
+
+enum Stage {
+	kStageRead,
+	kStageParse,
+	kStageRestore,
+	kStageWrite,
+	kStageDump,
+	kStageCount
+};
+
+const char *stageName(Stage stage);
+
+struct CompressionStats {
+	std::string name;
+	size_t chunkCount = 0;
+	uint64_t compressedBytes = 0;
+	uint64_t uncompressedBytes = 0;
+};
+
+/* FileStats */
+
+struct FileStats {
+	std::string path;
+	bool success = false;
+	uint64_t inputBytes = 0;
+	uint64_t bytesWritten = 0;
+	unsigned int version = 0;
+	uint32_t codec = 0;
+	double stageTimes[kStageCount] = {};
+	double totalTime = 0.0;
+	size_t peakRSS = 0;
+
+	std::map<uint32_t, size_t> chunkCounts;
+	std::map<std::string, CompressionStats> compression;
+	size_t scriptCount = 0;
+	size_t handlerCount = 0;
+	size_t bytecodeCount = 0;
+	size_t scriptCacheHits = 0;
+	size_t scriptCacheMisses = 0;
+	Common::MemoryTracker memory;
+
+	void collect(const Director::DirectorFile &dir);
+	void writeJSON(Common::JSONWriter &json) const;
+	std::string jsonLine() const;
+};
+
+void writeChunkCountsJSON(Common::JSONWriter &json, const std::map<uint32_t, size_t> &chunkCounts);
+void writeCompressionJSON(Common::JSONWriter &json, const std::map<std::string, CompressionStats> &compression);
+
+/* BatchStats */
+
+struct BatchStats {
+	size_t fileCount = 0;
+	size_t failureCount = 0;
+	uint64_t inputBytes = 0;
+	uint64_t bytesWritten = 0;
+	size_t scriptCount = 0;
+	size_t handlerCount = 0;
+	size_t bytecodeCount = 0;
+	size_t scriptCacheHits = 0;
+	size_t scriptCacheMisses = 0;
+	std::vector<double> totalTimes;
+	std::vector<double> stageTimes[kStageCount];
+
+	void add(const FileStats &stats);
+	void writeJSON(Common::JSONWriter &json) const;
+	std::string jsonLine() const;
+};
+
+/* StageTimer */
+
+class StageTimer {
+private:
+	double &_dest;
+	std::chrono::steady_clock::time_point _start;
+
+public:
+	StageTimer(double &dest) : _dest(dest), _start(std::chrono::steady_clock::now()) {}
+	~StageTimer();
+};
+
+size_t peakRSS();
+
+} // namespace IO
+
+#endif // IO_STATS_H
@@ -0,0 +1,231 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "common/stream.h"
+#include "io/symbolindex.h"
+
+namespace IO {
+
+static const uint32_t kSymbolIndexVersion = 1;
+static const size_t kHeaderSize = 32;
+static const size_t kTermSize = 16;
+
+const char *symbolKindName(SymbolKind kind) {
+	switch (kind) {
+	case kSymbolName:
+		return "name";
+	case kSymbolHandler:
+		return "handler";
+	case kSymbolCall:
+		return "call";
+	case kSymbolGlobal:
+		return "global";
+	case kSymbolProperty:
+		return "property";
+	case kSymbolSymbol:
+		return "symbol";
+	case kSymbolString:
+		return "string";
+	case kSymbolCastLib:
+		return "castLib";
+	default:
+		break;
+	}
+	return "unknown";
+}
+
+/* SymbolIndexWriter */
+
+void SymbolIndexWriter::addFile(uint32_t key, const std::string &path) {
+	_files[key] = path;
+}
+
+void SymbolIndexWriter::add(uint32_t key, SymbolKind kind, const std::string &name) {
+	_postings[std::make_pair(kind, name)].push_back(key);
+}
+
+std::vector<uint8_t> SymbolIndexWriter::build() const {
+	auto stringSize = [](const std::string &str) {
+		return Common::WriteStream::varIntSize(str.size()) + str.size();
+	};
+
+	// Number the files by key and sort each posting list by number
+	std::map<uint32_t, uint32_t> fileNumbers;
+	for (const auto &[key, path] : _files) {
+		fileNumbers.emplace(key, fileNumbers.size());
+	}
+	std::vector<std::vector<uint32_t>> postingLists;
+	postingLists.reserve(_postings.size());
+	for (const auto &[term, keys] : _postings) {
+		std::vector<uint32_t> files;
+		files.reserve(keys.size());
+		for (uint32_t key : keys) {
+			files.push_back(fileNumbers.at(key));
+		}
+		std::sort(files.begin(), files.end());
+		postingLists.push_back(std::move(files));
+	}
+
+	uint64_t filesOffset = kHeaderSize;
+	uint64_t termsOffset = filesOffset + 4 * _files.size();
+	uint64_t stringsOffset = termsOffset + kTermSize * _postings.size();
+	uint64_t postingsOffset = stringsOffset;
+	for (const auto &[key, path] : _files) {
+		postingsOffset += stringSize(path);
+	}
+	for (const auto &[term, keys] : _postings) {
+		postingsOffset += stringSize(term.second);
+	}
+	uint64_t size = postingsOffset;
+	for (const std::vector<uint32_t> &files : postingLists) {
+		uint32_t prev = 0;
+		for (uint32_t file : files) {
+			size += Common::WriteStream::varIntSize(file - prev);
+			prev = file;
+		}
+	}
+	if (size > UINT32_MAX)
+		throw std::runtime_error("Symbol index is larger than 4 GiB");
+
+	std::vector<uint8_t> buf(size);
+	Common::WriteStream header(buf.data(), kHeaderSize, Common::kLittleEndian);
+	header.writeString("PRIX");
+	header.writeUint32(kSymbolIndexVersion);
+	header.writeUint32(_files.size());
+	header.writeUint32(_postings.size());
+	header.writeUint32(filesOffset);
+	header.writeUint32(termsOffset);
+	header.writeUint32(stringsOffset);
+	header.writeUint32(postingsOffset);
+
+	Common::WriteStream table(buf.data(), size, Common::kLittleEndian, filesOffset);
+	Common::WriteStream strings(buf.data(), size, Common::kLittleEndian, stringsOffset);
+	Common::WriteStream postings(buf.data(), size, Common::kLittleEndian, postingsOffset);
+	auto writeString = [&strings](const std::string &str) {
+		uint32_t offset = strings.pos();
+		strings.writeVarInt(str.size());
+		strings.writeString(str);
+		return offset;
+	};
+
+	for (const auto &[key, path] : _files) {
+		table.writeUint32(writeString(path));
+	}
+	auto postingList = postingLists.begin();
+	for (const auto &[term, keys] : _postings) {
+		const std::vector<uint32_t> &files = *postingList++;
+		table.writeUint8(term.first);
+		table.writeUint8(0);
+		table.writeUint16(0);
+		table.writeUint32(writeString(term.second));
+		table.writeUint32(postings.pos());
+		table.writeUint32(files.size());
+
+		uint32_t prev = 0;
+		for (uint32_t file : files) {
+			postings.writeVarInt(file - prev);
+			prev = file;
+		}
+	}
+
+	return buf;
+}
+
+/* SymbolIndex */
+
+bool SymbolIndex::open(const std::filesystem::path &path) {
+	if (!_file.open(path))
+		return false;
+
+	if (_file.size() < kHeaderSize || std::memcmp(_file.data(), "PRIX", 4) != 0)
+		throw std::runtime_error(path.string() + " is not a symbol index");
+
+	Common::ReadStream header(_file.data(), kHeaderSize, Common::kLittleEndian, 4);
+	uint32_t version = header.readUint32();
+	if (version != kSymbolIndexVersion)
+		throw std::runtime_error(path.string() + " has unsupported symbol index version " + std::to_string(version));
+	_fileCount = header.readUint32();
+	_termCount = header.readUint32();
+	_filesOffset = header.readUint32();
+	_termsOffset = header.readUint32();
+	_stringsOffset = header.readUint32();
+	_postingsOffset = header.readUint32();
+
+	if ((uint64_t)_filesOffset + 4 * (uint64_t)_fileCount > _file.size()
+			|| (uint64_t)_termsOffset + kTermSize * (uint64_t)_termCount > _file.size())
+		throw std::runtime_error(path.string() + " is truncated");
+
+	return true;
+}
+
+// Points into the mapped index
+std::string_view SymbolIndex::readString(uint32_t offset) const {
+	Common::ReadStream stream(_file.data(), _file.size(), Common::kLittleEndian, offset);
+	uint32_t len = stream.readVarInt();
+	return stream.readStringView(len);
+}
+
+std::string SymbolIndex::filePath(uint32_t file) const {
+	Common::ReadStream table(_file.data(), _file.size(), Common::kLittleEndian, _filesOffset + 4 * file);
+	return std::string(readString(table.readUint32()));
+}
+
+// Compares term number index to the key, treating a term that starts with
+// name as equal if prefix is set
+int SymbolIndex::compareTerm(uint32_t index, SymbolKind kind, const std::string &name, bool prefix) const {
+	Common::ReadStream table(_file.data(), _file.size(), Common::kLittleEndian, _termsOffset + kTermSize * index);
+	uint8_t termKind = table.readUint8();
+	if (termKind != kind)
+		return (termKind < kind) ? -1 : 1;
+
+	table.skip(3);
+	std::string_view termName = readString(table.readUint32());
+	if (prefix && termName.size() > name.size())
+		termName = termName.substr(0, name.size());
+	return termName.compare(name);
+}
+
+std::vector<uint32_t> SymbolIndex::find(SymbolKind kind, const std::string &name, bool prefix) const {
+	// First matching term
+	uint32_t lo = 0;
+	uint32_t hi = _termCount;
+	while (lo < hi) {
+		uint32_t mid = lo + (hi - lo) / 2;
+		if (compareTerm(mid, kind, name, prefix) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	std::vector<uint32_t> files;
+	size_t termsMatched = 0;
+	for (uint32_t index = lo; index < _termCount && compareTerm(index, kind, name, prefix) == 0; index++) {
+		Common::ReadStream table(_file.data(), _file.size(), Common::kLittleEndian, _termsOffset + kTermSize * index + 8);
+		uint32_t postingsOffset = table.readUint32();
+		uint32_t count = table.readUint32();
+
+		Common::ReadStream postings(_file.data(), _file.size(), Common::kLittleEndian, postingsOffset);
+		uint32_t file = 0;
+		for (uint32_t i = 0; i < count; i++) {
+			file += postings.readVarInt();
+			files.push_back(file);
+		}
+		termsMatched++;
+	}
+
+	// A prefix can match several terms, whose lists overlap
+	if (termsMatched > 1) {
+		std::sort(files.begin(), files.end());
+		files.erase(std::unique(files.begin(), files.end()), files.end());
+	}
+	return files;
+}
+
+} // namespace IO
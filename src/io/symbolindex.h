@@ -0,0 +1,109 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef IO_SYMBOLINDEX_H
+#define IO_SYMBOLINDEX_H
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "io/fileio.h"
+
+namespace IO {
+
+enum SymbolKind : uint8_t {
+	kSymbolName,		// Any entry in a Lnam table
+	kSymbolHandler,		// A handler definition
+	kSymbolCall,		// A handler or method called by name
+	kSymbolGlobal,
+	kSymbolProperty,	// A script property, object property, or `the` property
+	kSymbolSymbol,		// A #symbol literal
+	kSymbolString,		// A string literal
+	kSymbolCastLib,		// A castLib referred to by name or number
+	kSymbolKindCount
+};
+
+const char *symbolKindName(SymbolKind kind);
+
+/**
+ * The symbol index maps (kind, lowercased name) terms to the files that
+ * contain them. It is laid out to be queried in place from a memory mapping,
+ * so a lookup only touches the pages it binary-searches through.
+ *
+ * All integers are little endian.
+ *
+ * Header:
+ *   0  "PRIX"
+ *   4  u32 format version
+ *   8  u32 file count
+ *  12  u32 term count
+ *  16  u32 offset of the file table
+ *  20  u32 offset of the term table
+ *  24  u32 offset of the string pool
+ *  28  u32 offset of the posting lists
+ *
+ * File table: a u32 string offset for each file's path.
+ *
+ * Term table, sorted by kind and then bytewise by name, 16 bytes per term:
+ *   u8 kind, 3 bytes padding, u32 string offset of the name,
+ *   u32 offset of its posting list, u32 number of files
+ *
+ * Strings are a varint length followed by the bytes. A posting list is the
+ * ascending file numbers as varints, each stored as the difference from the
+ * previous one.
+ */
+
+class SymbolIndexWriter {
+private:
+	std::map<uint32_t, std::string> _files;
+	std::map<std::pair<SymbolKind, std::string>, std::vector<uint32_t>> _postings;
+
+public:
+	// Files may be added in any order. They're numbered in order of their
+	// keys, so the index doesn't depend on which file finished first.
+	void addFile(uint32_t key, const std::string &path);
+	void add(uint32_t key, SymbolKind kind, const std::string &name);
+
+	size_t fileCount() const { return _files.size(); }
+	size_t termCount() const { return _postings.size(); }
+
+	std::vector<uint8_t> build() const;
+};
+
+class SymbolIndex {
+private:
+	MappedFile _file;
+	uint32_t _fileCount = 0;
+	uint32_t _termCount = 0;
+	uint32_t _filesOffset = 0;
+	uint32_t _termsOffset = 0;
+	uint32_t _stringsOffset = 0;
+	uint32_t _postingsOffset = 0;
+
+	std::string_view readString(uint32_t offset) const;
+	int compareTerm(uint32_t index, SymbolKind kind, const std::string &name, bool prefix) const;
+
+public:
+	// Returns false if the file can't be read, and throws if it isn't an index
+	bool open(const std::filesystem::path &path);
+
+	uint32_t fileCount() const { return _fileCount; }
+	uint32_t termCount() const { return _termCount; }
+	std::string filePath(uint32_t file) const;
+
+	// Numbers of the files containing the term, or any term starting with
+	// name if prefix is set, in ascending order. name must be lowercase.
+	std::vector<uint32_t> find(SymbolKind kind, const std::string &name, bool prefix) const;
+};
+
+} // namespace IO
+
+#endif // IO_SYMBOLINDEX_H
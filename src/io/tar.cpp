@@ -0,0 +1,107 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstring>
+
+#include "io/tar.h"
+
+namespace IO {
+
+static const size_t kBlockSize = 512;
+
+// Writes an octal number into a NUL-terminated field
+static void writeOctal(char *field, size_t fieldSize, uint64_t val) {
+	std::snprintf(field, fieldSize, "%0*llo", (int)(fieldSize - 1), (unsigned long long)val);
+}
+
+TarWriter::TarWriter(std::FILE *file) : _file(file), _mtime(std::time(nullptr)) {}
+
+void TarWriter::write(const void *data, size_t size) {
+	if (size > 0 && std::fwrite(data, 1, size, _file) != size)
+		_failed = true;
+}
+
+void TarWriter::writePadding(uint64_t size) {
+	static const char zeros[kBlockSize] = {};
+	size_t remainder = size % kBlockSize;
+	if (remainder != 0)
+		write(zeros, kBlockSize - remainder);
+}
+
+void TarWriter::writeHeader(const std::string &name, uint64_t size, char type) {
+	char header[kBlockSize] = {};
+
+	// ustar splits a long path into a prefix of up to 155 bytes and a name of
+	// up to 100, at a slash
+	std::string prefix;
+	std::string shortName = name;
+	if (name.size() > 100) {
+		size_t slash = name.find('/', name.size() > 101 ? name.size() - 101 : 0);
+		if (slash != std::string::npos && slash <= 155 && name.size() - slash - 1 <= 100) {
+			prefix = name.substr(0, slash);
+			shortName = name.substr(slash + 1);
+		} else {
+			// Doesn't fit; record the full path in a pax header first
+			std::string record = " path=" + name + "\n";
+			size_t length = record.size();
+			while (std::to_string(length).size() + record.size() != length) {
+				length = std::to_string(length).size() + record.size();
+			}
+			record = std::to_string(length) + record;
+
+			writeHeader("PaxHeaders/" + name.substr(name.size() - 80), record.size(), 'x');
+			write(record.data(), record.size());
+			writePadding(record.size());
+
+			shortName = name.substr(name.size() - 100);
+		}
+	}
+
+	std::memcpy(header, shortName.data(), shortName.size());
+	writeOctal(header + 100, 8, 0644); // mode
+	writeOctal(header + 108, 8, 0); // uid
+	writeOctal(header + 116, 8, 0); // gid
+	writeOctal(header + 124, 12, size);
+	writeOctal(header + 136, 12, (uint64_t)_mtime);
+	header[156] = type;
+	std::memcpy(header + 257, "ustar", 6);
+	std::memcpy(header + 263, "00", 2);
+	std::memcpy(header + 345, prefix.data(), prefix.size());
+
+	// The checksum is computed with its own field filled with spaces
+	std::memset(header + 148, ' ', 8);
+	unsigned int checksum = 0;
+	for (size_t i = 0; i < kBlockSize; i++) {
+		checksum += (uint8_t)header[i];
+	}
+	writeOctal(header + 148, 7, checksum);
+
+	write(header, kBlockSize);
+}
+
+void TarWriter::writeFile(const std::filesystem::path &path, const uint8_t *contents, size_t size) {
+	std::string name = path.generic_string();
+	while (name.size() > 0 && name[0] == '/') {
+		name.erase(0, 1);
+	}
+	while (name.compare(0, 2, "./") == 0) {
+		name.erase(0, 2);
+	}
+
+	writeHeader(name, size, '0');
+	write(contents, size);
+	writePadding(size);
+}
+
+bool TarWriter::finish() {
+	static const char zeros[kBlockSize * 2] = {};
+	write(zeros, sizeof(zeros));
+	if (std::fflush(_file) != 0)
+		_failed = true;
+	return !_failed;
+}
+
+} // namespace IO
@@ -0,0 +1,45 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef IO_TAR_H
+#define IO_TAR_H
+
+#include <cstdio>
+#include <ctime>
+#include <string>
+
+#include "io/fileio.h"
+
+namespace IO {
+
+/**
+ * TarWriter streams the files it receives into a POSIX tar archive, in
+ * order and without seeking, so it can write to a pipe. Paths that don't
+ * fit a ustar header get a pax extended header.
+ */
+
+class TarWriter : public FileSink {
+private:
+	std::FILE *_file;
+	std::time_t _mtime;
+	bool _failed = false;
+
+	void write(const void *data, size_t size);
+	void writePadding(uint64_t size);
+	void writeHeader(const std::string &name, uint64_t size, char type);
+
+public:
+	TarWriter(std::FILE *file);
+
+	void writeFile(const std::filesystem::path &path, const uint8_t *contents, size_t size) override;
+
+	// Writes the end-of-archive marker. Returns false if any write failed.
+	bool finish();
+};
+
+} // namespace IO
+
+#endif // IO_TAR_H
@@ -0,0 +1,77 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "io/threadpool.h"
+
+namespace IO {
+
+ThreadPool::ThreadPool(size_t threadCount, size_t maxQueued) : _maxQueued(maxQueued) {
+	if (threadCount == 0)
+		threadCount = 1;
+
+	for (size_t i = 0; i < threadCount; i++) {
+		_threads.emplace_back(&ThreadPool::workerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+	_jobAvailable.notify_all();
+	for (auto &thread : _threads) {
+		thread.join();
+	}
+}
+
+void ThreadPool::workerLoop() {
+	while (true) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_jobAvailable.wait(lock, [this]() { return _stopping || !_queue.empty(); });
+			if (_queue.empty())
+				return; // stopping, and nothing left to do
+
+			job = std::move(_queue.front());
+			_queue.pop_front();
+			_running++;
+		}
+		_spaceAvailable.notify_one();
+
+		job();
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_running--;
+			if (_running == 0 && _queue.empty())
+				_idle.notify_all();
+		}
+	}
+}
+
+void ThreadPool::enqueue(std::function<void()> job) {
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		if (_maxQueued > 0)
+			_spaceAvailable.wait(lock, [this]() { return _queue.size() < _maxQueued; });
+		_queue.push_back(std::move(job));
+	}
+	_jobAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+	std::unique_lock<std::mutex> lock(_mutex);
+	_idle.wait(lock, [this]() { return _running == 0 && _queue.empty(); });
+}
+
+size_t ThreadPool::defaultThreadCount() {
+	unsigned int count = std::thread::hardware_concurrency();
+	return (count > 0) ? count : 1;
+}
+
+} // namespace IO
@@ -0,0 +1,56 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef IO_THREADPOOL_H
+#define IO_THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace IO {
+
+/**
+ * ThreadPool runs jobs on a fixed set of worker threads. If maxQueued is
+ * nonzero, enqueue() blocks while that many jobs are waiting, so a fast
+ * producer can't buffer unbounded work.
+ *
+ * Jobs must not throw.
+ */
+
+class ThreadPool {
+private:
+	std::vector<std::thread> _threads;
+	std::deque<std::function<void()>> _queue;
+	size_t _maxQueued;
+	size_t _running = 0;
+	bool _stopping = false;
+
+	std::mutex _mutex;
+	std::condition_variable _jobAvailable;
+	std::condition_variable _spaceAvailable;
+	std::condition_variable _idle;
+
+	void workerLoop();
+
+public:
+	ThreadPool(size_t threadCount, size_t maxQueued = 0);
+	~ThreadPool(); // finishes every queued job
+
+	size_t size() const { return _threads.size(); }
+
+	void enqueue(std::function<void()> job);
+	void wait(); // blocks until every queued job has finished
+
+	static size_t defaultThreadCount();
+};
+
+} // namespace IO
+
+#endif // IO_THREADPOOL_H
@@ -0,0 +1,222 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <map>
+#include <stdexcept>
+
+#include "common/stream.h"
+#include "common/util.h"
+#include "director/chunk.h"
+#include "director/dirfile.h"
+#include "director/util.h"
+#include "lib/projectorrays.h"
+#include "lingodec/context.h"
+#include "lingodec/script.h"
+
+using namespace Director;
+
+namespace ProjectorRays {
+
+struct Movie::Impl {
+	Common::ReadStream stream;
+	DirectorFile dir;
+	bool decompiled = false;
+
+	Impl(const uint8_t *data, size_t size)
+		// The stream is never written to
+		: stream(const_cast<uint8_t *>(data), size) {}
+
+	// Reads every cast of a movie opened with lazyCasts
+	void readCasts() {
+		if (!dir.lazyCasts)
+			return;
+
+		dir.lazyCasts = false;
+		dir.casts.clear(); // only the casts extractScript has touched
+		dir.readCasts();
+		for (CastChunk *cast : dir.casts) {
+			if (cast->lctx)
+				cast->lctx->loadScripts();
+		}
+	}
+};
+
+Movie::Movie() = default;
+
+Movie::~Movie() = default;
+
+std::unique_ptr<Movie> Movie::open(const uint8_t *data, size_t size, const OpenOptions &options) {
+	std::unique_ptr<Movie> movie(new Movie());
+	movie->_impl = std::make_unique<Impl>(data, size);
+	movie->_impl->dir.memoryBudget = options.memoryBudget;
+	movie->_impl->dir.lazyCasts = options.lazyCasts;
+	if (!movie->_impl->dir.read(&movie->_impl->stream))
+		throw UnsupportedFormatError("Not a supported Director movie or cast");
+	return movie;
+}
+
+unsigned int Movie::version() const {
+	return _impl->dir.version;
+}
+
+std::string Movie::versionString() const {
+	return Director::versionString(_impl->dir.version, _impl->dir.fverVersionString);
+}
+
+bool Movie::isCast() const {
+	return _impl->dir.isCast();
+}
+
+bool Movie::isAfterburned() const {
+	return _impl->dir.afterburned;
+}
+
+std::vector<ChunkEntry> Movie::chunks() const {
+	std::vector<ChunkEntry> res;
+	res.reserve(_impl->dir.chunkInfo.size());
+	for (const auto &[id, info] : _impl->dir.chunkInfo) {
+		ChunkEntry entry;
+		entry.id = info.id;
+		entry.fourCC = info.fourCC;
+		entry.length = info.len;
+		entry.uncompressedLength = info.uncompressedLen;
+		entry.compression = info.compressionID.toString();
+		res.push_back(std::move(entry));
+	}
+	return res;
+}
+
+bool Movie::hasChunk(int32_t id) const {
+	return _impl->dir.chunkInfo.find(id) != _impl->dir.chunkInfo.end();
+}
+
+ByteView Movie::chunkData(int32_t id) {
+	auto it = _impl->dir.chunkInfo.find(id);
+	if (it == _impl->dir.chunkInfo.end())
+		throw std::runtime_error("Could not find chunk " + std::to_string(id));
+
+	Common::BufferView view = _impl->dir.getChunkData(it->second.fourCC, id);
+	ByteView res;
+	res.data = view.data();
+	res.size = view.size();
+	return res;
+}
+
+std::vector<CastEntry> Movie::casts() const {
+	_impl->readCasts();
+
+	std::vector<CastEntry> res;
+	for (const auto *cast : _impl->dir.casts) {
+		CastEntry entry;
+		entry.name = cast->name;
+		entry.scriptCount = cast->lctx ? cast->lctx->scripts.size() : 0;
+
+		std::map<const LingoDec::Script *, int32_t> scriptChunkIDs;
+		if (cast->lctx) {
+			for (const auto &[index, script] : cast->lctx->scripts) {
+				scriptChunkIDs[script] = cast->lctx->sectionMap[index - 1].sectionID;
+			}
+		}
+
+		for (const auto &[memberID, member] : cast->members) {
+			MemberEntry memberEntry;
+			memberEntry.id = member->id;
+			memberEntry.name = member->getName();
+			memberEntry.type = member->type;
+			memberEntry.scriptChunkID = -1;
+			auto it = scriptChunkIDs.find(member->script);
+			if (it != scriptChunkIDs.end())
+				memberEntry.scriptChunkID = it->second;
+			entry.members.push_back(std::move(memberEntry));
+		}
+		res.push_back(std::move(entry));
+	}
+	return res;
+}
+
+void Movie::decompile() {
+	if (_impl->decompiled)
+		return;
+
+	_impl->readCasts();
+	_impl->dir.config->unprotect();
+	_impl->dir.parseScripts();
+	_impl->dir.restoreScriptText();
+	_impl->decompiled = true;
+}
+
+void Movie::writeScripts(ScriptSink &sink, const std::string &lineEnding) {
+	decompile();
+
+	DirectorFile &dir = _impl->dir;
+	for (const auto *cast : dir.casts) {
+		if (!cast->lctx)
+			continue;
+
+		for (const auto &[index, script] : cast->lctx->scripts) {
+			ScriptChunk *scriptChunk = static_cast<ScriptChunk *>(script);
+			CastMemberChunk *member = scriptChunk->member;
+			if (!member)
+				continue;
+
+			ScriptEntry entry;
+			entry.castName = cast->name;
+			entry.memberID = member->id;
+			entry.memberName = member->getName();
+			entry.type = dir.scriptTypeName(member);
+			entry.chunkID = cast->lctx->sectionMap[index - 1].sectionID;
+
+			std::string source = script->scriptText(lineEnding.c_str(), dir.dotSyntax);
+			std::string bytecode = script->bytecodeText(lineEnding.c_str(), dir.dotSyntax);
+			sink.script(entry, source, bytecode);
+		}
+	}
+}
+
+bool Movie::extractScript(const std::string &castName, unsigned int memberID, ScriptSink &sink, const std::string &lineEnding) {
+	DirectorFile &dir = _impl->dir;
+	if (memberID > UINT16_MAX)
+		return false;
+	if (dir.lazyCasts)
+		dir.readMember(castName, memberID); // adds the member's cast to dir.casts
+
+	CastChunk *cast = nullptr;
+	CastMemberChunk *member = nullptr;
+	for (CastChunk *candidate : dir.casts) {
+		if (Common::compareIgnoreCase(candidate->name, castName) != 0)
+			continue;
+
+		auto it = candidate->members.find(memberID);
+		if (it != candidate->members.end()) {
+			cast = candidate;
+			member = it->second;
+		}
+		break;
+	}
+	if (!cast || !member || !member->script)
+		return false;
+
+	dir.parseScript(member->script);
+
+	ScriptEntry entry;
+	entry.castName = cast->name;
+	entry.memberID = member->id;
+	entry.memberName = member->getName();
+	entry.type = dir.scriptTypeName(member);
+	entry.chunkID = cast->lctx->sectionMap[member->getScriptID() - 1].sectionID;
+
+	std::string source = member->script->scriptText(lineEnding.c_str(), dir.dotSyntax);
+	std::string bytecode = member->script->bytecodeText(lineEnding.c_str(), dir.dotSyntax);
+	sink.script(entry, source, bytecode);
+	return true;
+}
+
+std::vector<uint8_t> Movie::write() {
+	decompile();
+	return _impl->dir.writeToBuffer();
+}
+
+} // namespace ProjectorRays
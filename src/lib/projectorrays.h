@@ -0,0 +1,130 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef LIB_PROJECTORRAYS_H
+#define LIB_PROJECTORRAYS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Public interface of libprojectorrays, for processing movies in memory
+ * without going through the projectorrays executable and temporary files.
+ *
+ * Errors are reported by throwing std::runtime_error. A Movie is not
+ * thread-safe, but separate Movies may be used from separate threads.
+ */
+
+namespace ProjectorRays {
+
+// Thrown by Movie::open() for data which isn't a supported movie or cast
+class UnsupportedFormatError : public std::runtime_error {
+public:
+	using std::runtime_error::runtime_error;
+};
+
+// A view into memory owned by a Movie
+struct ByteView {
+	const uint8_t *data = nullptr;
+	size_t size = 0;
+};
+
+struct ChunkEntry {
+	int32_t id;
+	uint32_t fourCC;
+	uint32_t length; // stored length
+	uint32_t uncompressedLength;
+	std::string compression; // compression GUID, as a string
+};
+
+struct MemberEntry {
+	unsigned int id;
+	std::string name;
+	unsigned int type; // Director::MemberType
+	int32_t scriptChunkID; // -1 if the member has no script
+};
+
+struct CastEntry {
+	std::string name;
+	std::vector<MemberEntry> members;
+	size_t scriptCount;
+};
+
+struct ScriptEntry {
+	std::string castName;
+	unsigned int memberID;
+	std::string memberName;
+	std::string type; // "MovieScript", "ParentScript", etc.
+	int32_t chunkID;
+};
+
+/**
+ * ScriptSink receives decompiled scripts from Movie::writeScripts(). The
+ * strings are only valid for the duration of the call.
+ */
+
+class ScriptSink {
+public:
+	virtual ~ScriptSink() = default;
+	virtual void script(const ScriptEntry &entry, const std::string &source, const std::string &bytecode) = 0;
+};
+
+struct OpenOptions {
+	size_t memoryBudget = 0; // budget for inflated chunk buffers in bytes, 0 for none
+
+	// Don't read the casts up front, so extractScript() only reads the chunks
+	// of the member it is asked for. Other calls read every cast first.
+	bool lazyCasts = false;
+};
+
+class Movie {
+private:
+	struct Impl;
+	std::unique_ptr<Impl> _impl;
+
+	Movie();
+
+public:
+	~Movie();
+
+	// Opens a movie or cast from a caller-owned buffer, which is read
+	// lazily and must outlive the Movie.
+	static std::unique_ptr<Movie> open(const uint8_t *data, size_t size, const OpenOptions &options = OpenOptions());
+
+	unsigned int version() const; // e.g. 850 for Director 8.5
+	std::string versionString() const;
+	bool isCast() const;
+	bool isAfterburned() const;
+
+	std::vector<ChunkEntry> chunks() const;
+	bool hasChunk(int32_t id) const;
+	// Inflated chunk data. With a memory budget, the view is only valid until
+	// the next call on this Movie: any call that inflates or decodes another
+	// chunk, including write() and script rendering, may evict it.
+	ByteView chunkData(int32_t id);
+
+	std::vector<CastEntry> casts() const;
+
+	// Parses every script and restores its source text. Called
+	// automatically by writeScripts() and write().
+	void decompile();
+	void writeScripts(ScriptSink &sink, const std::string &lineEnding = "\n");
+
+	// Decompiles one member's script and passes it to the sink. Returns false
+	// if the cast has no such member or the member has no script.
+	bool extractScript(const std::string &castName, unsigned int memberID, ScriptSink &sink, const std::string &lineEnding = "\n");
+
+	// The unprotected movie with restored source, as a file image
+	std::vector<uint8_t> write();
+};
+
+} // namespace ProjectorRays
+
+#endif // LIB_PROJECTORRAYS_H
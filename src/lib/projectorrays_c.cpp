@@ -0,0 +1,282 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "lib/projectorrays.h"
+#include "lib/projectorrays_c.h"
+
+using ProjectorRays::ChunkEntry;
+using ProjectorRays::Movie;
+using ProjectorRays::ScriptEntry;
+
+struct RenderedScript {
+	ScriptEntry entry;
+	std::string source;
+	std::string bytecode;
+};
+
+struct pr_movie {
+	std::unique_ptr<Movie> movie;
+	bool scriptsRendered = false;
+	std::vector<RenderedScript> scripts;
+	std::vector<uint8_t> written;
+};
+
+struct pr_chunk_iter {
+	std::vector<ChunkEntry> chunks;
+	size_t next = 0;
+};
+
+static thread_local std::string g_lastError;
+
+// Runs fn, translating any exception it throws into a status code
+template <typename F>
+static pr_status guard(F fn) {
+	g_lastError.clear();
+	try {
+		return fn();
+	} catch (const ProjectorRays::UnsupportedFormatError &e) {
+		g_lastError = e.what();
+		return PR_ERROR_UNSUPPORTED;
+	} catch (const std::bad_alloc &) {
+		g_lastError = "Out of memory";
+		return PR_ERROR_OUT_OF_MEMORY;
+	} catch (const std::length_error &e) {
+		// Usually a bogus length read from the file
+		g_lastError = e.what();
+		return PR_ERROR_CORRUPT;
+	} catch (const std::runtime_error &e) {
+		g_lastError = e.what();
+		return PR_ERROR_CORRUPT;
+	} catch (const std::exception &e) {
+		g_lastError = e.what();
+		return PR_ERROR_INTERNAL;
+	} catch (...) {
+		g_lastError = "Unknown error";
+		return PR_ERROR_INTERNAL;
+	}
+}
+
+static pr_status invalidArgument(const char *msg) {
+	g_lastError = msg;
+	return PR_ERROR_INVALID_ARGUMENT;
+}
+
+class RenderingSink : public ProjectorRays::ScriptSink {
+private:
+	std::vector<RenderedScript> &_scripts;
+
+public:
+	RenderingSink(std::vector<RenderedScript> &scripts) : _scripts(scripts) {}
+
+	virtual void script(const ScriptEntry &entry, const std::string &source, const std::string &bytecode) {
+		_scripts.push_back({ entry, source, bytecode });
+	}
+};
+
+static pr_status renderScripts(pr_movie *movie) {
+	if (movie->scriptsRendered)
+		return PR_OK;
+
+	// Render into a temporary so a failure doesn't leave half the scripts behind
+	std::vector<RenderedScript> scripts;
+	RenderingSink sink(scripts);
+	movie->movie->writeScripts(sink);
+	movie->scripts = std::move(scripts);
+	movie->scriptsRendered = true;
+	return PR_OK;
+}
+
+static pr_status getScript(pr_movie *movie, size_t index, RenderedScript **out) {
+	if (!movie)
+		return invalidArgument("movie is null");
+
+	pr_status status = renderScripts(movie);
+	if (status != PR_OK)
+		return status;
+	if (index >= movie->scripts.size()) {
+		g_lastError = "Script index " + std::to_string(index) + " out of range";
+		return PR_ERROR_NOT_FOUND;
+	}
+	*out = &movie->scripts[index];
+	return PR_OK;
+}
+
+extern "C" {
+
+const char *pr_last_error(void) {
+	return g_lastError.c_str();
+}
+
+/* Movies */
+
+pr_status pr_movie_open(const uint8_t *data, size_t size, size_t memory_budget, pr_movie **out) {
+	return guard([&]() {
+		if (!data || !out)
+			return invalidArgument("data and out must not be null");
+
+		ProjectorRays::OpenOptions options;
+		options.memoryBudget = memory_budget;
+		auto movie = std::make_unique<pr_movie>();
+		movie->movie = Movie::open(data, size, options);
+		*out = movie.release();
+		return PR_OK;
+	});
+}
+
+void pr_movie_close(pr_movie *movie) {
+	delete movie;
+}
+
+pr_status pr_movie_version(const pr_movie *movie, unsigned int *out) {
+	if (!movie || !out)
+		return invalidArgument("movie and out must not be null");
+
+	*out = movie->movie->version();
+	return PR_OK;
+}
+
+pr_status pr_movie_is_cast(const pr_movie *movie, int *out) {
+	if (!movie || !out)
+		return invalidArgument("movie and out must not be null");
+
+	*out = movie->movie->isCast() ? 1 : 0;
+	return PR_OK;
+}
+
+pr_status pr_movie_chunk_data(pr_movie *movie, int32_t id, const uint8_t **data, size_t *size) {
+	return guard([&]() {
+		if (!movie || !data || !size)
+			return invalidArgument("movie, data and size must not be null");
+
+		if (!movie->movie->hasChunk(id)) {
+			g_lastError = "Could not find chunk " + std::to_string(id);
+			return PR_ERROR_NOT_FOUND;
+		}
+
+		ProjectorRays::ByteView view = movie->movie->chunkData(id);
+		*data = view.data;
+		*size = view.size;
+		return PR_OK;
+	});
+}
+
+pr_status pr_movie_script_count(pr_movie *movie, size_t *out) {
+	return guard([&]() {
+		if (!movie || !out)
+			return invalidArgument("movie and out must not be null");
+
+		pr_status status = renderScripts(movie);
+		if (status == PR_OK)
+			*out = movie->scripts.size();
+		return status;
+	});
+}
+
+pr_status pr_movie_script_info(pr_movie *movie, size_t index, pr_script_info *out) {
+	return guard([&]() {
+		if (!out)
+			return invalidArgument("out must not be null");
+
+		RenderedScript *script;
+		pr_status status = getScript(movie, index, &script);
+		if (status != PR_OK)
+			return status;
+
+		out->cast_name = script->entry.castName.c_str();
+		out->member_id = script->entry.memberID;
+		out->member_name = script->entry.memberName.c_str();
+		out->type = script->entry.type.c_str();
+		out->chunk_id = script->entry.chunkID;
+		return PR_OK;
+	});
+}
+
+pr_status pr_movie_script_text(pr_movie *movie, size_t index, const char **data, size_t *size) {
+	return guard([&]() {
+		if (!data || !size)
+			return invalidArgument("data and size must not be null");
+
+		RenderedScript *script;
+		pr_status status = getScript(movie, index, &script);
+		if (status != PR_OK)
+			return status;
+
+		*data = script->source.data();
+		*size = script->source.size();
+		return PR_OK;
+	});
+}
+
+pr_status pr_movie_script_bytecode(pr_movie *movie, size_t index, const char **data, size_t *size) {
+	return guard([&]() {
+		if (!data || !size)
+			return invalidArgument("data and size must not be null");
+
+		RenderedScript *script;
+		pr_status status = getScript(movie, index, &script);
+		if (status != PR_OK)
+			return status;
+
+		*data = script->bytecode.data();
+		*size = script->bytecode.size();
+		return PR_OK;
+	});
+}
+
+pr_status pr_movie_write(pr_movie *movie, const uint8_t **data, size_t *size) {
+	return guard([&]() {
+		if (!movie || !data || !size)
+			return invalidArgument("movie, data and size must not be null");
+
+		movie->written = movie->movie->write();
+		*data = movie->written.data();
+		*size = movie->written.size();
+		return PR_OK;
+	});
+}
+
+/* Chunk iteration */
+
+pr_status pr_chunk_iter_open(const pr_movie *movie, pr_chunk_iter **out) {
+	return guard([&]() {
+		if (!movie || !out)
+			return invalidArgument("movie and out must not be null");
+
+		auto iter = std::make_unique<pr_chunk_iter>();
+		iter->chunks = movie->movie->chunks();
+		*out = iter.release();
+		return PR_OK;
+	});
+}
+
+void pr_chunk_iter_close(pr_chunk_iter *iter) {
+	delete iter;
+}
+
+pr_status pr_chunk_iter_next(pr_chunk_iter *iter, pr_chunk_info *out) {
+	if (!iter || !out)
+		return invalidArgument("iter and out must not be null");
+	if (iter->next >= iter->chunks.size()) {
+		g_lastError.clear();
+		return PR_ERROR_NOT_FOUND;
+	}
+
+	const ChunkEntry &entry = iter->chunks[iter->next++];
+	out->id = entry.id;
+	out->fourcc = entry.fourCC;
+	out->length = entry.length;
+	out->uncompressed_length = entry.uncompressedLength;
+	out->compression = entry.compression.c_str();
+	return PR_OK;
+}
+
+} // extern "C"
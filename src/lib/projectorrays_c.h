@@ -0,0 +1,113 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef LIB_PROJECTORRAYS_C_H
+#define LIB_PROJECTORRAYS_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * C interface to libprojectorrays, for callers which can't use the C++
+ * interface in projectorrays.h.
+ *
+ * Every function which can fail returns a pr_status. On failure, a
+ * description of the error is available from pr_last_error() on the same
+ * thread. No exception ever crosses this interface.
+ *
+ * Pointers returned through out parameters point into memory owned by the
+ * movie or iterator they came from; nothing is copied. Each function
+ * documents how long its results stay valid.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum pr_status {
+	PR_OK = 0,
+	PR_ERROR_INVALID_ARGUMENT = 1,
+	PR_ERROR_UNSUPPORTED = 2, /* not a movie or cast ProjectorRays can read */
+	PR_ERROR_CORRUPT = 3, /* the data is truncated or malformed */
+	PR_ERROR_NOT_FOUND = 4,
+	PR_ERROR_OUT_OF_MEMORY = 5,
+	PR_ERROR_INTERNAL = 6
+} pr_status;
+
+typedef struct pr_movie pr_movie;
+typedef struct pr_chunk_iter pr_chunk_iter;
+
+typedef struct pr_chunk_info {
+	int32_t id;
+	uint32_t fourcc;
+	uint32_t length; /* stored length */
+	uint32_t uncompressed_length;
+	const char *compression; /* compression GUID */
+} pr_chunk_info;
+
+typedef struct pr_script_info {
+	const char *cast_name;
+	uint32_t member_id;
+	const char *member_name;
+	const char *type; /* "MovieScript", "ParentScript", etc. */
+	int32_t chunk_id;
+} pr_script_info;
+
+/* Description of the last error on this thread, or "" if there was none */
+const char *pr_last_error(void);
+
+/* Movies */
+
+/*
+ * Opens a movie or cast from a caller-owned buffer, which is read lazily
+ * and must outlive the movie. memory_budget limits inflated chunk buffers
+ * in bytes, or is 0 for no limit.
+ */
+pr_status pr_movie_open(const uint8_t *data, size_t size, size_t memory_budget, pr_movie **out);
+void pr_movie_close(pr_movie *movie);
+
+pr_status pr_movie_version(const pr_movie *movie, unsigned int *out);
+pr_status pr_movie_is_cast(const pr_movie *movie, int *out);
+
+/*
+ * Inflated data of a chunk, valid until the movie is closed. With a memory
+ * budget, it is only valid until the next call on the same movie, since any
+ * call that inflates or decodes another chunk may evict it, including
+ * pr_movie_write() and the script functions.
+ */
+pr_status pr_movie_chunk_data(pr_movie *movie, int32_t id, const uint8_t **data, size_t *size);
+
+/*
+ * Decompiled scripts, rendered on first use. Script info and text are
+ * valid until the movie is closed.
+ */
+pr_status pr_movie_script_count(pr_movie *movie, size_t *out);
+pr_status pr_movie_script_info(pr_movie *movie, size_t index, pr_script_info *out);
+pr_status pr_movie_script_text(pr_movie *movie, size_t index, const char **data, size_t *size);
+pr_status pr_movie_script_bytecode(pr_movie *movie, size_t index, const char **data, size_t *size);
+
+/*
+ * The unprotected movie with restored source, as a file image. Valid until
+ * the next call to pr_movie_write() or until the movie is closed.
+ */
+pr_status pr_movie_write(pr_movie *movie, const uint8_t **data, size_t *size);
+
+/* Chunk iteration */
+
+pr_status pr_chunk_iter_open(const pr_movie *movie, pr_chunk_iter **out);
+void pr_chunk_iter_close(pr_chunk_iter *iter);
+
+/*
+ * Fetches the next chunk's info, which is valid until the next call.
+ * Returns PR_ERROR_NOT_FOUND after the last chunk.
+ */
+pr_status pr_chunk_iter_next(pr_chunk_iter *iter, pr_chunk_info *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIB_PROJECTORRAYS_C_H */
@@ -143,6 +143,8 @@ void AST::exitBlock() {
 
 /* Node */
 
+thread_local size_t Node::liveCount = 0;
+
 std::shared_ptr<Datum> Node::getValue() {
 	return std::make_shared<Datum>();
 }
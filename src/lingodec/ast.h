@@ -64,8 +64,15 @@ struct Node {
 	bool isLoop;
 	Node *parent;
 
-	Node(NodeType t) : type(t), isExpression(false), isStatement(false), isLabel(false), isLoop(false), parent(nullptr) {}
-	virtual ~Node() = default;
+	// Number of nodes alive on the current thread, for memory accounting
+	static thread_local size_t liveCount;
+
+	Node(NodeType t) : type(t), isExpression(false), isStatement(false), isLabel(false), isLoop(false), parent(nullptr) {
+		liveCount++;
+	}
+	virtual ~Node() {
+		liveCount--;
+	}
 	virtual void writeScriptText(Common::CodeWriter&, bool, bool) const {}
 	virtual std::shared_ptr<Datum> getValue();
 	Node *ancestorStatement();
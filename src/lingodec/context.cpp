@@ -17,9 +17,9 @@ struct ScriptContextMapEntry;
 
 /* ScriptContext */
 
-void ScriptContext::read(Common::ReadStream &stream) {
+void ScriptContext::read(Common::ReadStream &chunkStream) {
 	// Lingo scripts are always big endian regardless of file endianness
-	stream.endianness = Common::kBigEndian;
+	Common::BigEndianReadStream stream(chunkStream);
 
 	unknown0 = stream.readInt32();
 	unknown1 = stream.readInt32();
@@ -40,15 +40,34 @@ void ScriptContext::read(Common::ReadStream &stream) {
 	for (auto &entry : sectionMap) {
 		entry.read(stream);
 	}
+	chunkStream.seek(stream.pos());
 
 	lnam = resolver->getScriptNames(lnamSectionID);
-	for (uint32_t i = 1; i <= entryCount; i++) {
-		auto section = sectionMap[i - 1];
-		if (section.sectionID > -1) {
-			Script *script = resolver->getScript(section.sectionID);
-			script->setContext(this);
-			scripts[i] = script;
-		}
+	if (!lazy)
+		loadScripts();
+}
+
+Script *ScriptContext::loadScript(uint32_t number) {
+	auto it = scripts.find(number);
+	if (it != scripts.end())
+		return it->second;
+
+	if (number < 1 || number > sectionMap.size() || sectionMap[number - 1].sectionID < 0)
+		return nullptr;
+
+	Script *script = resolver->getScript(sectionMap[number - 1].sectionID);
+	script->setContext(this);
+	scripts[number] = script;
+	return script;
+}
+
+void ScriptContext::loadScripts() {
+	if (scriptsLoaded)
+		return;
+	scriptsLoaded = true;
+
+	for (uint32_t i = 1; i <= sectionMap.size(); i++) {
+		loadScript(i);
 	}
 
 	for (auto it = scripts.begin(); it != scripts.end(); ++it) {
@@ -76,7 +95,7 @@ void ScriptContext::parseScripts() {
 
 /* ScriptContextMapEntry */
 
-void ScriptContextMapEntry::read(Common::ReadStream &stream) {
+void ScriptContextMapEntry::read(Common::BigEndianReadStream &stream) {
 	unknown0 = stream.readInt32();
 	sectionID = stream.readInt32();
 	unknown1 = stream.readUint16();
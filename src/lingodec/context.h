@@ -11,9 +11,7 @@
 #include <map>
 #include <vector>
 
-namespace Common {
-class ReadStream;
-}
+#include "common/stream.h"
 
 namespace LingoDec {
 
@@ -45,12 +43,19 @@ struct ScriptContext {
 	std::vector<ScriptContextMapEntry> sectionMap;
 	std::map<uint32_t, Script *> scripts;
 
+	bool lazy; // If set, read() leaves loading scripts to loadScript and loadScripts
+	bool scriptsLoaded;
+
 	ScriptContext(unsigned int version, ChunkResolver *resolver) :
 		version(version),
 		resolver(resolver),
-		lnam(nullptr) {}
+		lnam(nullptr),
+		lazy(false),
+		scriptsLoaded(false) {}
 
 	void read(Common::ReadStream &stream);
+	Script *loadScript(uint32_t number);
+	void loadScripts();
 	bool validName(int id) const;
 	std::string getName(int id) const;
 	void parseScripts();
@@ -64,7 +69,7 @@ struct ScriptContextMapEntry {
 	uint16_t unknown1;
 	uint16_t unknown2;
 
-	void read(Common::ReadStream &stream);
+	void read(Common::BigEndianReadStream &stream);
 };
 
 } // namespace LingoDec
@@ -23,27 +23,28 @@ namespace LingoDec {
 
 /* Handler */
 
-void Handler::readRecord(Common::ReadStream &stream) {
-	nameID = stream.readInt16();
-	vectorPos = stream.readUint16();
-	compiledLen = stream.readUint32();
-	compiledOffset = stream.readUint32();
-	argumentCount = stream.readUint16();
-	argumentOffset = stream.readUint32();
-	localsCount = stream.readUint16();
-	localsOffset = stream.readUint32();
-	globalsCount = stream.readUint16();
-	globalsOffset = stream.readUint32();
-	unknown1 = stream.readUint32();
-	unknown2 = stream.readUint16();
-	lineCount = stream.readUint16();
-	lineOffset = stream.readUint32();
+void Handler::readRecord(Common::BigEndianReadStream &stream) {
+	Common::BigEndianReadCursor record = stream.reserve((script->version >= 850) ? 46 : 42);
+	nameID = record.readInt16();
+	vectorPos = record.readUint16();
+	compiledLen = record.readUint32();
+	compiledOffset = record.readUint32();
+	argumentCount = record.readUint16();
+	argumentOffset = record.readUint32();
+	localsCount = record.readUint16();
+	localsOffset = record.readUint32();
+	globalsCount = record.readUint16();
+	globalsOffset = record.readUint32();
+	unknown1 = record.readUint32();
+	unknown2 = record.readUint16();
+	lineCount = record.readUint16();
+	lineOffset = record.readUint32();
 	// yet to implement
 	if (script->version >= 850)
-		stackHeight = stream.readUint32();
+		stackHeight = record.readUint32();
 }
 
-void Handler::readData(Common::ReadStream &stream) {
+void Handler::readData(Common::BigEndianReadStream &stream) {
 	stream.seek(compiledOffset);
 	while (stream.pos() < compiledOffset + compiledLen) {
 		uint32_t pos = stream.pos() - compiledOffset;
@@ -82,13 +83,10 @@ void Handler::readData(Common::ReadStream &stream) {
 	globalNameIDs = readVarnamesTable(stream, globalsCount, globalsOffset);
 }
 
-std::vector<int16_t> Handler::readVarnamesTable(Common::ReadStream &stream, uint16_t count, uint32_t offset) {
+std::vector<int16_t> Handler::readVarnamesTable(Common::BigEndianReadStream &stream, uint16_t count, uint32_t offset) {
 	stream.seek(offset);
-	std::vector<int16_t> nameIDs;
-	nameIDs.resize(count);
-	for (size_t i = 0; i < count; i++) {
-		nameIDs[i] = stream.readUint16();
-	}
+	std::vector<int16_t> nameIDs(count);
+	stream.readInt16Array(nameIDs.data(), count);
 	return nameIDs;
 }
 
@@ -12,12 +12,12 @@
 #include <string>
 #include <vector>
 
+#include "common/stream.h"
 #include "lingodec/enums.h"
 
 namespace Common {
 class CodeWriter;
 class JSONWriter;
-class ReadStream;
 }
 
 namespace LingoDec {
@@ -67,9 +67,9 @@ struct Handler {
 		script = s;
 	}
 
-	void readRecord(Common::ReadStream &stream);
-	void readData(Common::ReadStream &stream);
-	std::vector<int16_t> readVarnamesTable(Common::ReadStream &stream, uint16_t count, uint32_t offset);
+	void readRecord(Common::BigEndianReadStream &stream);
+	void readData(Common::BigEndianReadStream &stream);
+	std::vector<int16_t> readVarnamesTable(Common::BigEndianReadStream &stream, uint16_t count, uint32_t offset);
 	void readNames();
 	bool validName(int id) const;
 	std::string getName(int id) const;
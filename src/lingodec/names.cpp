@@ -304,9 +304,9 @@ std::string StandardNames::getName(const std::map<unsigned int, std::string> &na
 
 /* ScriptNames */
 
-void ScriptNames::read(Common::ReadStream &stream) {
+void ScriptNames::read(Common::ReadStream &chunkStream) {
 	// Lingo scripts are always big endian regardless of file endianness
-	stream.endianness = Common::kBigEndian;
+	Common::BigEndianReadStream stream(chunkStream);
 
 	unknown0 = stream.readInt32();
 	unknown1 = stream.readInt32();
@@ -321,6 +321,7 @@ void ScriptNames::read(Common::ReadStream &stream) {
 		auto length = stream.readUint8();
 		name = stream.readString(length);
 	}
+	chunkStream.seek(stream.pos());
 }
 
 bool ScriptNames::validName(int id) const {
@@ -17,40 +17,42 @@ namespace LingoDec {
 
 Script::Script(unsigned int version) :
 	version(version),
-	context(nullptr) {}
+	context(nullptr),
+	parsed(false) {}
 
 Script::~Script() = default;
 
-void Script::read(Common::ReadStream &stream) {
+void Script::read(Common::ReadStream &chunkStream) {
 	// Lingo scripts are always big endian regardless of file endianness
-	stream.endianness = Common::kBigEndian;
+	Common::BigEndianReadStream stream(chunkStream);
 
 	stream.seek(8);
-	/*  8 */ totalLength = stream.readUint32();
-	/* 12 */ totalLength2 = stream.readUint32();
-	/* 16 */ headerLength = stream.readUint16();
-	/* 18 */ scriptNumber = stream.readUint16();
-	/* 20 */ unk20 = stream.readInt16();
-	/* 22 */ parentNumber = stream.readInt16();
+	Common::BigEndianReadCursor header = stream.reserve(84);
+	/*  8 */ totalLength = header.readUint32();
+	/* 12 */ totalLength2 = header.readUint32();
+	/* 16 */ headerLength = header.readUint16();
+	/* 18 */ scriptNumber = header.readUint16();
+	/* 20 */ unk20 = header.readInt16();
+	/* 22 */ parentNumber = header.readInt16();
 	
-	stream.seek(38);
-	/* 38 */ scriptFlags = stream.readUint32();
-	/* 42 */ unk42 = stream.readInt16();
-	/* 44 */ castID = stream.readInt32();
-	/* 48 */ factoryNameID = stream.readInt16();
-	/* 50 */ handlerVectorsCount = stream.readUint16();
-	/* 52 */ handlerVectorsOffset = stream.readUint32();
-	/* 56 */ handlerVectorsSize = stream.readUint32();
-	/* 60 */ propertiesCount = stream.readUint16();
-	/* 62 */ propertiesOffset = stream.readUint32();
-	/* 66 */ globalsCount = stream.readUint16();
-	/* 68 */ globalsOffset = stream.readUint32();
-	/* 72 */ handlersCount = stream.readUint16();
-	/* 74 */ handlersOffset = stream.readUint32();
-	/* 78 */ literalsCount = stream.readUint16();
-	/* 80 */ literalsOffset = stream.readUint32();
-	/* 84 */ literalsDataCount = stream.readUint32();
-	/* 88 */ literalsDataOffset = stream.readUint32();
+	/* 24 */ header.skip(14);
+	/* 38 */ scriptFlags = header.readUint32();
+	/* 42 */ unk42 = header.readInt16();
+	/* 44 */ castID = header.readInt32();
+	/* 48 */ factoryNameID = header.readInt16();
+	/* 50 */ handlerVectorsCount = header.readUint16();
+	/* 52 */ handlerVectorsOffset = header.readUint32();
+	/* 56 */ handlerVectorsSize = header.readUint32();
+	/* 60 */ propertiesCount = header.readUint16();
+	/* 62 */ propertiesOffset = header.readUint32();
+	/* 66 */ globalsCount = header.readUint16();
+	/* 68 */ globalsOffset = header.readUint32();
+	/* 72 */ handlersCount = header.readUint16();
+	/* 74 */ handlersOffset = header.readUint32();
+	/* 78 */ literalsCount = header.readUint16();
+	/* 80 */ literalsOffset = header.readUint32();
+	/* 84 */ literalsDataCount = header.readUint32();
+	/* 88 */ literalsDataOffset = header.readUint32();
 
 	propertyNameIDs = readVarnamesTable(stream, propertiesCount, propertiesOffset);
 	globalNameIDs = readVarnamesTable(stream, globalsCount, globalsOffset);
@@ -79,14 +81,13 @@ void Script::read(Common::ReadStream &stream) {
 	for (auto &literal : literals) {
 		literal.readData(stream, literalsDataOffset);
 	}
+	chunkStream.seek(stream.pos());
 }
 
-std::vector<int16_t> Script::readVarnamesTable(Common::ReadStream &stream, uint16_t count, uint32_t offset) {
+std::vector<int16_t> Script::readVarnamesTable(Common::BigEndianReadStream &stream, uint16_t count, uint32_t offset) {
 	stream.seek(offset);
 	std::vector<int16_t> nameIDs(count);
-	for (uint16_t i = 0; i < count; i++) {
-		nameIDs[i] = stream.readInt16();
-	}
+	stream.readInt16Array(nameIDs.data(), count);
 	return nameIDs;
 }
 
@@ -122,6 +123,10 @@ void Script::setContext(ScriptContext *ctx) {
 }
 
 void Script::parse() {
+	if (parsed)
+		return;
+	parsed = true;
+
 	for (const auto &handler : handlers) {
 		handler->parse();
 	}
@@ -216,7 +221,7 @@ bool Script::isFactory() const {
 
 /* LiteralStore */
 
-void LiteralStore::readRecord(Common::ReadStream &stream, int version) {
+void LiteralStore::readRecord(Common::BigEndianReadStream &stream, int version) {
 	if (version >= 500)
 		type = static_cast<LiteralType>(stream.readUint32());
 	else
@@ -224,7 +229,7 @@ void LiteralStore::readRecord(Common::ReadStream &stream, int version) {
 	offset = stream.readUint32();
 }
 
-void LiteralStore::readData(Common::ReadStream &stream, uint32_t startOffset) {
+void LiteralStore::readData(Common::BigEndianReadStream &stream, uint32_t startOffset) {
 	if (type == kLiteralInt) {
 		value = std::make_shared<LingoDec::Datum>((int)offset);
 	} else {
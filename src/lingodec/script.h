@@ -11,11 +11,11 @@
 #include <string>
 #include <vector>
 
+#include "common/stream.h"
 #include "lingodec/enums.h"
 
 namespace Common {
 class CodeWriter;
-class ReadStream;
 }
 
 namespace LingoDec {
@@ -31,8 +31,8 @@ struct LiteralStore {
 	uint32_t offset;
 	std::shared_ptr<Datum> value;
 
-	void readRecord(Common::ReadStream &stream, int version);
-	void readData(Common::ReadStream &stream, uint32_t startOffset);
+	void readRecord(Common::BigEndianReadStream &stream, int version);
+	void readData(Common::BigEndianReadStream &stream, uint32_t startOffset);
 };
 
 /* Script */
@@ -75,11 +75,12 @@ struct Script {
 
 	unsigned int version;
 	ScriptContext *context;
+	bool parsed;
 
 	Script(unsigned int version);
 	~Script();
 	void read(Common::ReadStream &stream);
-	std::vector<int16_t> readVarnamesTable(Common::ReadStream &stream, uint16_t count, uint32_t offset);
+	std::vector<int16_t> readVarnamesTable(Common::BigEndianReadStream &stream, uint16_t count, uint32_t offset);
 	bool validName(int id) const;
 	std::string getName(int id) const;
 	void setContext(ScriptContext *ctx);
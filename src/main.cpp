@@ -4,95 +4,209 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include <algorithm>
+#include <cstdio>
 #include <cstdlib>
 #include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
 #include <vector>
 
 namespace fs = std::filesystem;
 
+#include "common/json.h"
 #include "common/log.h"
 #include "common/stream.h"
 #include "common/util.h"
 #include "director/chunk.h"
 #include "director/dirfile.h"
+#include "director/symbols.h"
 #include "director/util.h"
 #include "io/options.h"
 #include "io/fileio.h"
+#include "io/scriptcache.h"
+#include "io/server.h"
+#include "io/stats.h"
+#include "io/symbolindex.h"
+#include "io/tar.h"
+#include "io/threadpool.h"
 
 using namespace Director;
 
-bool processFile(fs::path input, IO::Options &options, bool outputIsDirectory) {
-	std::vector<uint8_t> buf;
-	if (!IO::readFile(input, buf)) {
-		Common::warning(boost::format("Could not read %s!") % input);
-		return false;
+// A served request's input, sent inline, and the decompiled file to send
+// back when no output path was given
+struct InMemoryFile {
+	std::vector<uint8_t> input;
+	std::string outputName;
+	std::vector<uint8_t> output;
+};
+
+// What processFile produced, for callers that report it
+struct FileResult {
+	std::string version;
+	std::vector<fs::path> outputs;
+	std::string script; // extract's source or bytecode
+};
+
+// Shared by every file decompiled in this process, so a script that appears
+// in several files is only decompiled once
+IO::ScriptCache *g_scriptCache = nullptr;
+
+// Decodes the sounds of each file in turn. When several files are processed
+// at once, they already use every CPU, so there is none.
+IO::ThreadPool *g_soundPool = nullptr;
+
+bool writesToStdout(IO::Options &options) {
+	return options.hasOption("output") && options.stringValue("output") == "-";
+}
+
+// With a script cache, scripts are parsed only when they miss, while they're
+// being rendered. That time goes to the parse stage rather than the stage
+// doing the rendering.
+template <typename Fn>
+void timeRendering(IO::FileStats &stats, IO::Stage stage, DirectorFile &dir, Fn fn) {
+	double parseTimeBefore = dir.scriptParseTime;
+	{
+		IO::StageTimer timer(stats.stageTimes[stage]);
+		fn();
 	}
+	double parseTime = dir.scriptParseTime - parseTimeBefore;
+	stats.stageTimes[stage] -= parseTime;
+	stats.stageTimes[IO::kStageParse] += parseTime;
+}
 
-	Common::ReadStream stream(buf.data(), buf.size());
-	auto dir = std::make_unique<DirectorFile>();
-	if (!dir->read(&stream))
-		return false;
+// Outputs go in outputDir if it is set, to the --output file if that isn't a
+// directory, or next to the input otherwise. An input of - is read from stdin.
+bool processFile(fs::path input, IO::Options &options, const fs::path &outputDir, IO::FileStats &stats, InMemoryFile *inMemory = nullptr, FileResult *result = nullptr) {
+	IO::StageTimer totalTimer(stats.totalTime);
+	uint64_t bytesWrittenBefore = IO::g_bytesWritten;
+	stats.path = input.string();
+
+	std::vector<uint8_t> buf;
+	Common::ReadStream stream(nullptr, 0); // chunks are read lazily, so this must outlive dir
+	std::unique_ptr<DirectorFile> dir;
+	{
+		IO::StageTimer timer(stats.stageTimes[IO::kStageRead]);
+		if (inMemory) {
+			buf = std::move(inMemory->input);
+		} else if (input == "-") {
+			if (!IO::readStdin(buf)) {
+				Common::warning("Could not read stdin!");
+				return false;
+			}
+		} else if (!IO::readFile(input, buf)) {
+			Common::warning(boost::format("Could not read %s!") % input);
+			return false;
+		}
+		stats.inputBytes = buf.size();
+
+		stream = Common::ReadStream(buf.data(), buf.size());
+		dir = std::make_unique<DirectorFile>();
+		dir->memoryBudget = options.memoryBudget();
+		dir->lazyCasts = (options.cmd() == IO::kCmdExtract);
+		dir->scriptCache = g_scriptCache;
+		dir->soundPool = g_soundPool;
+		if (!dir->read(&stream))
+			return false;
+	}
 
 	fs::path decompileOutput;
 	fs::path dumpOutput;
-	if (options.hasOption("output") && !outputIsDirectory) {
+	if (options.hasOption("output") && outputDir.empty() && !writesToStdout(options)) {
 		decompileOutput = options.stringValue("output");
 	} else {
-		std::string oldExtension = input.extension().string();
+		fs::path namePath = (input == "-") ? fs::path("stdin") : input;
+		std::string oldExtension = namePath.extension().string();
 		std::string newExtension = (dir->isCast()) ? ".cst" : ".dir";
-		std::string fileName = input.stem().string();
+		std::string fileName = namePath.stem().string();
 		std::string decompileFileName = (Common::compareIgnoreCase(oldExtension, newExtension) == 0)
 											? fileName + "_decompiled" + newExtension
 											: fileName + newExtension;
 		std::string dumpDirName = (oldExtension.size() == 0)
 										? fileName + "_dump"
 										: fileName;
-		if (options.hasOption("output") && outputIsDirectory) {
-			decompileOutput = dumpOutput = fs::path(options.stringValue("output"));
+		if (!outputDir.empty()) {
+			decompileOutput = dumpOutput = outputDir;
 			decompileOutput /= decompileFileName;
 			dumpOutput /= dumpDirName;
+		} else if (writesToStdout(options)) {
+			// Names within the stream
+			decompileOutput = decompileFileName;
+			dumpOutput = dumpDirName;
 		} else {
-			decompileOutput = dumpOutput = input;
+			decompileOutput = dumpOutput = namePath;
 			decompileOutput.replace_filename(decompileFileName);
 			dumpOutput.replace_filename(dumpDirName);
 		}
 	}
 	if (options.hasDumpOptions()) {
-		fs::create_directory(dumpOutput);
+		IO::createDirectory(dumpOutput);
+		if (result)
+			result->outputs.push_back(dumpOutput);
 	}
 	fs::path castsOutput = dumpOutput / std::string("casts");
 	if (options.hasCastDumpOptions()) {
-		fs::create_directory(castsOutput);
+		IO::createDirectory(castsOutput);
 	}
 	fs::path chunksOutput = dumpOutput / std::string("chunks");
 	if (options.hasChunkDumpOptions()) {
-		fs::create_directory(chunksOutput);
+		IO::createDirectory(chunksOutput);
 	}
 
-	if (options.hasOption("dump-chunks")) {
-		dir->dumpChunks(chunksOutput);
-	}
-	if (options.hasOption("dump-json")) {
-		dir->dumpJSON(chunksOutput);
+	{
+		IO::StageTimer timer(stats.stageTimes[IO::kStageDump]);
+		if (options.hasOption("dump-chunks")) {
+			dir->dumpChunks(chunksOutput);
+		}
+		if (options.hasOption("dump-json")) {
+			dir->dumpJSON(chunksOutput);
+		}
 	}
 
 	unsigned int version = humanVersion(dir->config->directorVersion);
+	if (result)
+		result->version = versionString(version, dir->fverVersionString);
 	switch (options.cmd()) {
 	case IO::kCmdDecompile:
 		{
 			dir->config->unprotect();
-			dir->parseScripts();
+			{
+				IO::StageTimer timer(stats.stageTimes[IO::kStageParse]);
+				dir->parseScripts();
+			}
 			if (options.hasOption("dump-scripts")) {
-				dir->dumpScripts(castsOutput);
+				timeRendering(stats, IO::kStageDump, *dir, [&]() { dir->dumpScripts(castsOutput); });
+			}
+			if (options.hasOption("dump-sounds")) {
+				IO::StageTimer timer(stats.stageTimes[IO::kStageDump]);
+				Director::SoundFileFormat format = Director::kSoundFileWAV;
+				if (options.hasOption("sound-format")) {
+					format = (Director::SoundFileFormat)options.enumValue("sound-format");
+				}
+				dir->dumpSounds(castsOutput, format);
+			}
+			timeRendering(stats, IO::kStageRestore, *dir, [&]() { dir->restoreScriptText(); });
+			std::string outputName = decompileOutput.string();
+			{
+				IO::StageTimer timer(stats.stageTimes[IO::kStageWrite]);
+				if (inMemory && !options.hasOption("output")) {
+					inMemory->output = dir->writeToBuffer();
+					inMemory->outputName = outputName = decompileOutput.filename().string();
+				} else {
+					dir->writeToFile(decompileOutput);
+					if (result)
+						result->outputs.push_back(decompileOutput);
+				}
 			}
-			dir->restoreScriptText();
-			dir->writeToFile(decompileOutput);
 
 			std::string fileType = (dir->isCast()) ? "cast" : "movie";
 			Common::log(
 				"Decompiled " + versionString(version, dir->fverVersionString) + " " + fileType
-				+ " " + input.string() + " to " + decompileOutput.string()
+				+ " " + input.string() + " to " + outputName
 			);
 		}
 		break;
@@ -118,13 +232,701 @@ bool processFile(fs::path input, IO::Options &options, bool outputIsDirectory) {
 			}
 		}
 		break;
+	case IO::kCmdExtract:
+		{
+			if (!options.hasOption("member")) {
+				Common::warning("extract requires --member");
+				return false;
+			}
+			std::string castName = options.hasOption("cast") ? options.stringValue("cast") : "Internal";
+			unsigned long long memberID = options.unsignedValue("member");
+			CastMemberChunk *member = (memberID <= UINT16_MAX) ? dir->readMember(castName, memberID) : nullptr;
+			if (!member) {
+				Common::warning(boost::format("Cast %s has no member %llu!") % castName % memberID);
+				return false;
+			}
+			if (!member->script) {
+				Common::warning(boost::format("Member %llu of cast %s has no script!") % memberID % castName);
+				return false;
+			}
+
+			if (!dir->scriptCache) {
+				IO::StageTimer timer(stats.stageTimes[IO::kStageParse]);
+				dir->parseScript(member->script);
+			}
+			std::string text;
+			timeRendering(stats, IO::kStageRestore, *dir, [&]() {
+				text = dir->renderScript(member->script, "\n", options.hasOption("bytecode"));
+			});
+			if (!text.empty() && text.back() == '\n')
+				text.pop_back(); // log adds its own
+			if (result)
+				result->script = text;
+			Common::log(text);
+		}
+		break;
 	default:
 		break;
 	}
 
+	stats.collect(*dir);
+	stats.bytesWritten = IO::g_bytesWritten - bytesWrittenBefore;
+	stats.success = true;
+	return true;
+}
+
+void writeStats(IO::Options &options, const std::string &line) {
+	if (options.hasOption("stats-file")) {
+		IO::appendLine(options.stringValue("stats-file"), line);
+	} else if (options.hasOption("stats")) {
+		Common::log(line);
+	}
+}
+
+fs::path outputDirectory(IO::Options &options, bool outputIsDirectory) {
+	return outputIsDirectory ? fs::path(options.stringValue("output")) : fs::path();
+}
+
+bool processFile(fs::path input, IO::Options &options, bool outputIsDirectory, IO::BatchStats *batchStats = nullptr) {
+	IO::FileStats stats;
+	bool success = false;
+	try {
+		success = processFile(input, options, outputDirectory(options, outputIsDirectory), stats);
+	} catch (const std::exception &e) {
+		// A malformed file fails like any other, so it's still counted
+		Common::warning("Could not process " + input.string() + ": " + e.what());
+	}
+	stats.peakRSS = IO::peakRSS();
+	if (batchStats) {
+		batchStats->add(stats);
+	}
+	writeStats(options, stats.jsonLine());
+	return success;
+}
+
+bool checkOutput(IO::Options &options, bool &outputIsDirectory) {
+	outputIsDirectory = false;
+	if (options.hasOption("output")) {
+		fs::path output = options.stringValue("output");
+		if (fs::is_directory(output)) {
+			outputIsDirectory = true;
+		} else if (options.hasDumpOptions()) {
+			Common::warning(boost::format("Output must be a directory when a --dump- option is used!"));
+			return false;
+		}
+	}
+	return true;
+}
+
+bool prepareOutputDirectory(IO::Options &options, const std::string &error) {
+	if (options.hasOption("output")) {
+		fs::path output = options.stringValue("output");
+		if (fs::exists(output)) {
+			if (!fs::is_directory(output)) {
+				Common::warning(error);
+				return false;
+			}
+		} else {
+			fs::create_directory(output);
+		}
+	}
+	return true;
+}
+
+class ScopedLogHandler {
+public:
+	ScopedLogHandler(Common::LogHandler handler) { Common::setThreadLogHandler(std::move(handler)); }
+	~ScopedLogHandler() { Common::setThreadLogHandler(nullptr); }
+};
+
+class ScopedFileSink {
+public:
+	ScopedFileSink(IO::FileSink *sink) { IO::setThreadFileSink(sink); }
+	~ScopedFileSink() { IO::setThreadFileSink(nullptr); }
+};
+
+// Passes the single file written without dump options straight through
+class StdoutSink : public IO::FileSink {
+public:
+	bool failed = false;
+
+	void writeFile(const fs::path &, const uint8_t *contents, size_t size) override {
+		if (size > 0 && std::fwrite(contents, 1, size, stdout) != size)
+			failed = true;
+	}
+};
+
+// Writes the decompiled file to stdout, or with dump options, a tar stream
+// of it and the dumps. Log messages go to stderr so they don't mix with the
+// data.
+int processToStdout(fs::path input, IO::Options &options) {
+	ScopedLogHandler logHandler([](bool, const std::string &msg) {
+		std::cerr << msg << "\n";
+	});
+	IO::setStdoutBinary();
+
+	bool success;
+	if (options.hasDumpOptions()) {
+		IO::TarWriter tar(stdout);
+		{
+			ScopedFileSink fileSink(&tar);
+			success = processFile(input, options, false);
+		}
+		// End the archive even after a failure, so it stays readable
+		if (!tar.finish()) {
+			Common::warning("Could not write to stdout!");
+			success = false;
+		}
+	} else {
+		StdoutSink sink;
+		{
+			ScopedFileSink fileSink(&sink);
+			success = processFile(input, options, false);
+		}
+		if (sink.failed || std::fflush(stdout) != 0) {
+			Common::warning("Could not write to stdout!");
+			success = false;
+		}
+	}
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Runs one request on a server thread. Its arguments are parsed like a
+// command line, and everything it logs goes back to the client.
+void serveRequest(IO::ServeRequest &request, IO::ServeResponse &response) {
+	ScopedLogHandler logHandler([&response](bool isWarning, const std::string &msg) {
+		response.log(isWarning, msg);
+	});
+
+	std::vector<std::string> args = request.args;
+	args.insert(args.begin(), "projectorrays");
+	std::vector<char *> argv;
+	for (std::string &arg : args) {
+		argv.push_back(arg.data());
+	}
+
+	IO::Options options;
+	options.parse(argv.size(), argv.data());
+	if (!options.valid()) {
+		response.result(false, "Invalid arguments", nullptr);
+		return;
+	}
+	if (options.cmd() == IO::kCmdServe) {
+		response.result(false, "A request cannot start another server", nullptr);
+		return;
+	}
+
+	fs::path input = options.inputFile();
+	if (!request.hasData && input == "-") {
+		response.result(false, "stdin is not available to requests; send the file inline", nullptr);
+		return;
+	}
+	if (writesToStdout(options)) {
+		response.result(false, "stdout is not available to requests; omit --output to get the file back", nullptr);
+		return;
+	}
+	if (!request.hasData && fs::is_directory(input)) {
+		response.result(false, "Directory input is not supported by serve; send one request per file", nullptr);
+		return;
+	}
+	if (request.hasData && options.hasDumpOptions() && !options.hasOption("output")) {
+		response.result(false, "--output is required to dump a file sent inline", nullptr);
+		return;
+	}
+	bool outputIsDirectory;
+	if (!checkOutput(options, outputIsDirectory)) {
+		response.result(false, "Invalid output path", nullptr);
+		return;
+	}
+
+	IO::FileStats stats;
+	InMemoryFile inMemory;
+	if (request.hasData)
+		inMemory.input = std::move(request.data);
+	bool success = processFile(input, options, outputDirectory(options, outputIsDirectory), stats, request.hasData ? &inMemory : nullptr);
+	stats.peakRSS = IO::peakRSS();
+
+	if (success && !inMemory.outputName.empty())
+		response.output(inMemory.outputName, inMemory.output.data(), inMemory.output.size());
+	response.result(success, success ? "" : "Could not process " + input.string(), &stats);
+}
+
+size_t jobCount(IO::Options &options) {
+	if (options.hasOption("jobs"))
+		return std::max<size_t>(options.unsignedValue("jobs"), 1);
+	return IO::ThreadPool::defaultThreadCount();
+}
+
+// Mirrors a relative manifest entry's directories under the output directory,
+// so files with the same name in different directories don't collide
+fs::path manifestOutputDirectory(const fs::path &outputRoot, const fs::path &input) {
+	if (outputRoot.empty())
+		return fs::path();
+
+	fs::path parent = input.parent_path().lexically_normal();
+	if (input.is_relative() && !parent.empty() && parent != "." && *parent.begin() != "..")
+		return outputRoot / parent;
+	return outputRoot;
+}
+
+std::string manifestRecord(size_t index, const IO::FileStats &stats, const FileResult &result, const std::string &error, const std::vector<std::string> &warnings, bool includeStats) {
+	Common::JSONWriter json("", "", Common::kJSONStrict);
+	json.startObject();
+		json.writeField("type", "result");
+		json.writeField("index", (uint64_t)index);
+		json.writeField("path", stats.path);
+		json.writeField("status", stats.success ? "ok" : "failed");
+		if (!error.empty())
+			json.writeField("error", error);
+		json.writeField("version", stats.version);
+		json.writeField("versionString", result.version);
+		json.writeKey("outputs");
+		json.startArray();
+			for (const fs::path &output : result.outputs) {
+				json.writeVal(output.string());
+			}
+		json.endArray();
+		if (!result.script.empty())
+			json.writeField("script", result.script);
+		json.writeKey("warnings");
+		json.startArray();
+			for (const std::string &warning : warnings) {
+				json.writeVal(warning);
+			}
+		json.endArray();
+		json.writeKey("stageTimes");
+		json.startObject();
+			for (int stage = 0; stage < IO::kStageCount; stage++) {
+				json.writeField(IO::stageName((IO::Stage)stage), stats.stageTimes[stage]);
+			}
+		json.endObject();
+		json.writeField("totalTime", stats.totalTime);
+		if (includeStats) {
+			json.writeKey("stats");
+			stats.writeJSON(json);
+		}
+	json.endObject();
+	return json.str();
+}
+
+// Calls fn with each path in the --files-from list, skipping blank lines.
+// Returns false if the list can't be read.
+bool forEachListedFile(IO::Options &options, const std::function<void(const std::string &)> &fn) {
+	std::string listPath = options.stringValue("files-from");
+	std::ifstream listFile;
+	std::istream *list = &std::cin;
+	if (listPath != "-") {
+		listFile.open(listPath, std::ios::binary);
+		if (!listFile.is_open()) {
+			Common::warning("Could not read " + listPath + "!");
+			return false;
+		}
+		list = &listFile;
+	}
+	char separator = options.hasOption("null") ? '\0' : '\n';
+
+	std::string line;
+	while (std::getline(*list, line, separator)) {
+		if (separator == '\n' && !line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (!line.empty())
+			fn(line);
+	}
 	return true;
 }
 
+// Processes every file listed in --files-from on a thread pool. Each file's
+// result is printed as one JSON line as soon as it finishes, so the order
+// follows completion; "index" is the file's position in the list, and an
+// extracted script is in "script". Unlike directory mode, a failed file
+// doesn't stop the rest.
+int processManifest(IO::Options &options) {
+	if (!prepareOutputDirectory(options, "Output must be a directory when --files-from is used!"))
+		return EXIT_FAILURE;
+	fs::path outputRoot = options.hasOption("output") ? fs::path(options.stringValue("output")) : fs::path();
+
+	std::mutex resultsMutex;
+	IO::BatchStats batchStats;
+	bool listRead;
+	{
+		// The bounded queue keeps a long list from being read ahead of the workers
+		size_t jobs = jobCount(options);
+		IO::ThreadPool pool(jobs, jobs * 4);
+
+		size_t index = 0;
+		listRead = forEachListedFile(options, [&](const std::string &line) {
+			pool.enqueue([&, index, line]() {
+				fs::path input = line;
+				IO::FileStats stats;
+				FileResult result;
+				std::string error;
+				std::vector<std::string> warnings;
+				{
+					ScopedLogHandler logHandler([&warnings](bool isWarning, const std::string &msg) {
+						if (isWarning)
+							warnings.push_back(msg);
+					});
+					try {
+						if (input == "-")
+							throw std::runtime_error("stdin cannot be listed in --files-from");
+						fs::path outputDir = manifestOutputDirectory(outputRoot, input);
+						if (!outputDir.empty())
+							fs::create_directories(outputDir);
+						processFile(input, options, outputDir, stats, nullptr, &result);
+					} catch (const std::exception &e) {
+						error = e.what();
+					}
+				}
+				stats.path = input.string();
+				stats.peakRSS = IO::peakRSS();
+				if (!stats.success && error.empty())
+					error = warnings.empty() ? "Could not process file" : warnings.back();
+
+				std::string record = manifestRecord(index, stats, result, error, warnings, options.hasOption("stats"));
+				std::lock_guard<std::mutex> lock(resultsMutex);
+				batchStats.add(stats);
+				std::cout << record << std::endl;
+				if (options.hasOption("stats-file"))
+					IO::appendLine(options.stringValue("stats-file"), stats.jsonLine());
+			});
+			index++;
+		});
+	}
+	writeStats(options, batchStats.jsonLine());
+
+	return (listRead && batchStats.failureCount == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Movies, casts, and their protected and published forms
+bool isDirectorFile(const fs::path &path) {
+	static const char *const extensions[] = { ".dir", ".dxr", ".dcr", ".cst", ".cxt", ".cct" };
+	std::string extension = path.extension().string();
+	for (const char *ext : extensions) {
+		if (Common::compareIgnoreCase(extension, ext) == 0)
+			return true;
+	}
+	return false;
+}
+
+// Describes a file using only its map, key table, config, and cast list, as
+// one JSON line. Nothing is decompiled, and an Afterburner file's ILS is only
+// inflated as far as those chunks.
+std::string scanFile(size_t index, const fs::path &input, bool &success) {
+	double time = 0.0;
+	std::string error;
+	std::vector<std::string> warnings;
+	IO::MappedFile file;
+	std::vector<uint8_t> stdinBuf;
+	Common::ReadStream stream(nullptr, 0);
+	DirectorFile dir;
+	dir.lazyCasts = true;
+	std::vector<CastListing> casts;
+	std::map<int32_t, size_t> memberCounts;
+	success = false;
+	{
+		IO::StageTimer timer(time);
+		ScopedLogHandler logHandler([&warnings](bool isWarning, const std::string &msg) {
+			if (isWarning)
+				warnings.push_back(msg);
+		});
+		try {
+			bool fileRead = (input == "-") ? IO::readStdin(stdinBuf) : file.open(input);
+			if (!fileRead)
+				throw std::runtime_error("Could not read " + input.string() + "!");
+			stream = (input == "-") ? Common::ReadStream(stdinBuf.data(), stdinBuf.size()) : Common::ReadStream(file.data(), file.size());
+
+			if (dir.read(&stream)) {
+				casts = dir.listCasts();
+				for (const CastListing &listing : casts) {
+					if (listing.sectionID <= 0)
+						continue;
+					CastChunk *cast = static_cast<CastChunk *>(dir.getChunk(FOURCC('C', 'A', 'S', '*'), listing.sectionID));
+					memberCounts[listing.sectionID] = std::count_if(cast->memberIDs.begin(), cast->memberIDs.end(), [](int32_t id) {
+						return id > 0;
+					});
+				}
+				success = true;
+			}
+		} catch (const std::exception &e) {
+			error = e.what();
+		}
+	}
+	if (!success && error.empty())
+		error = warnings.empty() ? "Could not read file" : warnings.back();
+
+	Common::JSONWriter json("", "", Common::kJSONStrict);
+	json.startObject();
+		json.writeField("index", (uint64_t)index);
+		json.writeField("path", input.string());
+		json.writeField("status", success ? "ok" : "failed");
+		if (!error.empty())
+			json.writeField("error", error);
+		json.writeField("size", (uint64_t)stream.size());
+		if (dir.codec != 0) {
+			json.writeFourCCField("codec", dir.codec);
+			json.writeField("endianness", (dir.endianness == Common::kBigEndian) ? "big" : "little");
+		}
+		if (success) {
+			json.writeField("fileType", dir.isCast() ? "cast" : "movie");
+			if (dir.afterburned)
+				json.writeField("fver", dir.fverVersionString);
+			json.writeField("version", dir.version);
+			json.writeField("versionString", versionString(dir.version, dir.fverVersionString));
+			json.writeField("directorVersion", (unsigned int)dir.config->directorVersion);
+
+			json.writeField("chunkCount", (uint64_t)dir.chunkInfo.size());
+			json.writeKey("chunks");
+			json.startObject();
+				for (const auto &[fourCC, ids] : dir.chunkIDsByFourCC) {
+					if (!ids.empty())
+						json.writeField(Common::rawFourCC(fourCC), (uint64_t)ids.size());
+				}
+			json.endObject();
+
+			struct CompressionTotals {
+				MoaID id;
+				uint64_t chunks = 0;
+				uint64_t compressedBytes = 0;
+				uint64_t uncompressedBytes = 0;
+			};
+			std::map<std::string, CompressionTotals> compression;
+			for (const auto &[id, info] : dir.chunkInfo) {
+				CompressionTotals &totals = compression[info.compressionID.toString()];
+				totals.id = info.compressionID;
+				totals.chunks++;
+				totals.compressedBytes += info.len;
+				totals.uncompressedBytes += info.uncompressedLen;
+			}
+			json.writeKey("compression");
+			json.startArray();
+				for (const auto &[guid, totals] : compression) {
+					json.startObject();
+						json.writeField("id", guid);
+						json.writeField("name", compressionName(totals.id));
+						json.writeField("chunks", totals.chunks);
+						json.writeField("compressedBytes", totals.compressedBytes);
+						json.writeField("uncompressedBytes", totals.uncompressedBytes);
+					json.endObject();
+				}
+			json.endArray();
+
+			json.writeKey("casts");
+			json.startArray();
+				for (const CastListing &listing : casts) {
+					json.startObject();
+						json.writeField("name", listing.name);
+						json.writeField("members", (uint64_t)memberCounts[listing.sectionID]);
+					json.endObject();
+				}
+			json.endArray();
+		}
+		json.writeKey("warnings");
+		json.startArray();
+			for (const std::string &warning : warnings) {
+				json.writeVal(warning);
+			}
+		json.endArray();
+		json.writeField("time", time);
+	json.endObject();
+	return json.str();
+}
+
+// Calls fn with the input file, every Director file under the input
+// directory, or each file listed in --files-from. Returns false if the
+// directory or list can't be read.
+bool forEachInputFile(IO::Options &options, const std::function<void(const fs::path &)> &fn) {
+	if (options.hasOption("files-from")) {
+		return forEachListedFile(options, [&fn](const std::string &line) {
+			fn(line);
+		});
+	}
+
+	fs::path input = options.inputFile();
+	if (input == "-" || !fs::is_directory(input)) {
+		fn(input);
+		return true;
+	}
+
+	std::error_code ec;
+	for (auto it = fs::recursive_directory_iterator(input, fs::directory_options::skip_permission_denied, ec);
+			it != fs::recursive_directory_iterator(); it.increment(ec)) {
+		if (ec)
+			break;
+		if (it->is_regular_file(ec) && isDirectorFile(it->path()))
+			fn(it->path());
+	}
+	if (ec) {
+		Common::warning("Could not read " + input.string() + ": " + ec.message());
+		return false;
+	}
+	return true;
+}
+
+// Scans each input file on a thread pool, printing a JSON line for each as it
+// finishes
+int scan(IO::Options &options) {
+	std::mutex resultsMutex;
+	size_t failures = 0;
+	bool inputsRead;
+	{
+		size_t jobs = jobCount(options);
+		IO::ThreadPool pool(jobs, jobs * 4);
+
+		size_t index = 0;
+		inputsRead = forEachInputFile(options, [&](const fs::path &path) {
+			pool.enqueue([&, index, path]() {
+				bool success;
+				std::string record = scanFile(index, path, success);
+				std::lock_guard<std::mutex> lock(resultsMutex);
+				if (!success)
+					failures++;
+				std::cout << record << "\n";
+			});
+			index++;
+		});
+	}
+	std::cout.flush();
+
+	return (inputsRead && failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Reads the scripts of one file for the symbol index
+bool indexFile(const fs::path &input, bool parse, SymbolSet &symbols) {
+	IO::MappedFile file;
+	std::vector<uint8_t> stdinBuf;
+	bool fileRead = (input == "-") ? IO::readStdin(stdinBuf) : file.open(input);
+	if (!fileRead) {
+		Common::warning("Could not read " + input.string() + "!");
+		return false;
+	}
+	Common::ReadStream stream = (input == "-") ? Common::ReadStream(stdinBuf.data(), stdinBuf.size()) : Common::ReadStream(file.data(), file.size());
+
+	DirectorFile dir;
+	dir.lazyCasts = true;
+	if (!dir.read(&stream))
+		return false;
+	collectSymbols(dir, parse, symbols);
+	return true;
+}
+
+// Collects the symbols of each input file on a thread pool, then writes them
+// all as one index
+int buildIndex(IO::Options &options) {
+	if (!options.hasOption("index")) {
+		Common::warning("index requires --index");
+		return EXIT_FAILURE;
+	}
+
+	std::mutex indexMutex;
+	IO::SymbolIndexWriter writer;
+	size_t failures = 0;
+	bool inputsRead;
+	{
+		size_t jobs = jobCount(options);
+		IO::ThreadPool pool(jobs, jobs * 4);
+		bool parse = options.hasOption("parse");
+
+		uint32_t index = 0;
+		inputsRead = forEachInputFile(options, [&](const fs::path &path) {
+			pool.enqueue([&, index, path]() {
+				SymbolSet symbols;
+				std::string error;
+				bool success = false;
+				{
+					std::vector<std::string> warnings;
+					ScopedLogHandler logHandler([&warnings](bool isWarning, const std::string &msg) {
+						if (isWarning)
+							warnings.push_back(msg);
+					});
+					try {
+						success = indexFile(path, parse, symbols);
+					} catch (const std::exception &e) {
+						error = e.what();
+					}
+					if (!success && error.empty())
+						error = warnings.empty() ? "Could not read file" : warnings.back();
+				}
+
+				std::lock_guard<std::mutex> lock(indexMutex);
+				if (!success) {
+					Common::warning("Could not index " + path.string() + ": " + error);
+					failures++;
+					return;
+				}
+				writer.addFile(index, path.string());
+				for (const auto &[kind, name] : symbols) {
+					writer.add(index, kind, name);
+				}
+			});
+			index++;
+		});
+	}
+
+	fs::path indexPath = options.stringValue("index");
+	std::vector<uint8_t> indexData = writer.build();
+	IO::writeFile(indexPath, indexData.data(), indexData.size());
+	Common::log(boost::format("Indexed %zu symbols in %zu files to %s")
+		% writer.termCount() % writer.fileCount() % indexPath.string());
+	if (failures > 0)
+		Common::warning(boost::format("%zu files could not be indexed") % failures);
+
+	return (inputsRead && failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Prints the path of each indexed file that uses the term
+int query(IO::Options &options) {
+	if (!options.hasOption("index")) {
+		Common::warning("query requires --index");
+		return EXIT_FAILURE;
+	}
+
+	IO::SymbolIndex index;
+	try {
+		if (!index.open(options.stringValue("index"))) {
+			Common::warning("Could not read " + options.stringValue("index") + "!");
+			return EXIT_FAILURE;
+		}
+	} catch (const std::exception &e) {
+		Common::warning(e.what());
+		return EXIT_FAILURE;
+	}
+
+	std::string term = Common::toLowercase(options.inputFile());
+	bool prefix = !term.empty() && term.back() == '*';
+	if (prefix)
+		term.pop_back();
+
+	IO::SymbolKind kind = IO::kSymbolKindCount;
+	if (options.hasOption("kind"))
+		kind = (IO::SymbolKind)options.enumValue("kind");
+
+	std::vector<uint32_t> files;
+	for (int k = 0; k < IO::kSymbolKindCount; k++) {
+		if (kind != IO::kSymbolKindCount && kind != k)
+			continue;
+		std::vector<uint32_t> kindFiles = index.find((IO::SymbolKind)k, term, prefix);
+		files.insert(files.end(), kindFiles.begin(), kindFiles.end());
+	}
+	std::sort(files.begin(), files.end());
+	files.erase(std::unique(files.begin(), files.end()), files.end());
+
+	for (uint32_t file : files) {
+		std::cout << index.filePath(file) << "\n";
+	}
+	std::cout.flush();
+
+	return files.empty() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int serve(IO::Options &options) {
+	if (!options.hasOption("socket")) {
+		Common::warning("serve requires --socket");
+		return EXIT_FAILURE;
+	}
+	IO::Server server(options.stringValue("socket"), jobCount(options), serveRequest);
+	return server.run() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 int main(int argc, char *argv[]) {
 	IO::Options options;
 	options.parse(argc, argv);
@@ -135,19 +937,51 @@ int main(int argc, char *argv[]) {
 		Common::g_verbose = true;
 	}
 
+	IO::ScriptCache scriptCache;
+	if (options.cmd() == IO::kCmdDecompile || options.cmd() == IO::kCmdExtract || options.cmd() == IO::kCmdServe) {
+		if (options.hasOption("script-cache")) {
+			uint64_t capacity = IO::ScriptCache::kDefaultStoreCapacity;
+			if (options.hasOption("script-cache-size"))
+				capacity = (uint64_t)options.unsignedValue("script-cache-size") * 1024 * 1024;
+			scriptCache.setStore(options.stringValue("script-cache"), capacity);
+		}
+		g_scriptCache = &scriptCache;
+	}
+
+	if (options.cmd() == IO::kCmdServe) {
+		return serve(options);
+	}
+	if (options.cmd() == IO::kCmdScan) {
+		return scan(options);
+	}
+	if (options.cmd() == IO::kCmdIndex) {
+		return buildIndex(options);
+	}
+	if (options.cmd() == IO::kCmdQuery) {
+		return query(options);
+	}
+	std::unique_ptr<IO::ThreadPool> soundPool;
+	if (!options.hasOption("files-from") && jobCount(options) > 1) {
+		soundPool = std::make_unique<IO::ThreadPool>(jobCount(options));
+		g_soundPool = soundPool.get();
+	}
+	if (writesToStdout(options)) {
+		if (options.hasOption("files-from") || fs::is_directory(options.inputFile())) {
+			Common::warning("Only a single file can be written to stdout!");
+			return EXIT_FAILURE;
+		}
+		return processToStdout(options.inputFile(), options);
+	}
+	if (options.hasOption("files-from")) {
+		return processManifest(options);
+	}
+
 	fs::path input = options.inputFile();
 	if (fs::is_directory(input)) {
-		if (options.hasOption("output")) {
-			fs::path output = options.stringValue("output");
-			if (fs::exists(output)) {
-				if (!fs::is_directory(output)) {
-					Common::warning(boost::format("Output must be a directory when input is a directory!"));
-					return EXIT_FAILURE;
-				}
-			} else {
-				fs::create_directory(output);
-			}
-		}
+		if (!prepareOutputDirectory(options, "Output must be a directory when input is a directory!"))
+			return EXIT_FAILURE;
+		IO::BatchStats batchStats;
+		bool success = true;
 		for (const fs::directory_entry &dirEntry : fs::directory_iterator(input)) {
 			if (!dirEntry.is_regular_file())
 				continue;
@@ -160,20 +994,19 @@ int main(int argc, char *argv[]) {
 					|| Common::compareIgnoreCase(extension, ".cxt") == 0))
 				continue;
 
-			if (!processFile(path, options, true))
-				return EXIT_FAILURE;
-		}
-	} else {
-		bool outputIsDirectory = false;
-		if (options.hasOption("output")) {
-			fs::path output = options.stringValue("output");
-			if (fs::is_directory(output)) {
-				outputIsDirectory = true;
-			} else if (options.hasDumpOptions()) {
-				Common::warning(boost::format("Output must be a directory when a --dump- option is used!"));
-				return EXIT_FAILURE;
+			if (!processFile(path, options, true, &batchStats)) {
+				success = false;
+				break;
 			}
 		}
+		// The files processed before a failure are still reported
+		writeStats(options, batchStats.jsonLine());
+		if (!success)
+			return EXIT_FAILURE;
+	} else {
+		bool outputIsDirectory;
+		if (!checkOutput(options, outputIsDirectory))
+			return EXIT_FAILURE;
 		if (!processFile(input, options, outputIsDirectory))
 			return EXIT_FAILURE;
 	}
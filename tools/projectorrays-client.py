@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+#
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+"""Minimal client for `projectorrays serve`.
+
+    projectorrays-client.py SOCKET [--inline] [-O DIR] -- ARGS...
+
+ARGS are projectorrays command line arguments, e.g. `decompile movie.dcr`.
+With --inline, the input file is read here and sent over the socket, and a
+decompiled file the server sends back is saved to DIR (default: the current
+directory). Log messages go to stderr and the result to stdout.
+"""
+
+import argparse
+import json
+import os
+import socket
+import struct
+import sys
+
+
+def send_frame(sock, payload):
+    sock.sendall(struct.pack(">I", len(payload)) + payload)
+
+
+def recv_exact(sock, size):
+    buf = bytearray()
+    while len(buf) < size:
+        chunk = sock.recv(min(size - len(buf), 1 << 20))
+        if not chunk:
+            raise EOFError("server closed the connection")
+        buf += chunk
+    return bytes(buf)
+
+
+def recv_frame(sock):
+    (size,) = struct.unpack(">I", recv_exact(sock, 4))
+    return recv_exact(sock, size)
+
+
+def input_path(args):
+    # The first argument that isn't the command or an option, or an option's value
+    takes_value = {"-o", "--output", "--style", "--memory-budget", "--stats-file"}
+    skip = False
+    for arg in args[1:]:
+        if skip:
+            skip = False
+        elif arg in takes_value:
+            skip = True
+        elif not arg.startswith("-"):
+            return arg
+    return None
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("socket")
+    parser.add_argument("--inline", action="store_true", help="send the input file's contents")
+    parser.add_argument("-O", "--output-dir", default=".", help="where to save returned files")
+    argv = sys.argv[1:]
+    if "--" not in argv:
+        parser.error("expected -- before the projectorrays arguments")
+    split = argv.index("--")
+    opts = parser.parse_args(argv[:split])
+    args = argv[split + 1:]
+
+    header = {"id": 1, "args": args}
+    data = None
+    if opts.inline:
+        path = input_path(args)
+        if path is None:
+            parser.error("no input path in ARGS")
+        with open(path, "rb") as f:
+            data = f.read()
+        header["dataSize"] = len(data)
+
+    with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as sock:
+        sock.connect(opts.socket)
+        send_frame(sock, json.dumps(header).encode())
+        if data is not None:
+            send_frame(sock, data)
+
+        while True:
+            msg = json.loads(recv_frame(sock))
+            if msg["type"] == "log":
+                print(msg["message"], file=sys.stderr)
+            elif msg["type"] == "output":
+                payload = recv_frame(sock)
+                os.makedirs(opts.output_dir, exist_ok=True)
+                dest = os.path.join(opts.output_dir, os.path.basename(msg["name"]))
+                with open(dest, "wb") as f:
+                    f.write(payload)
+                print("Saved %s (%d bytes)" % (dest, len(payload)), file=sys.stderr)
+            elif msg["type"] == "result":
+                print(json.dumps(msg))
+                return 0 if msg["success"] else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())